@@ -0,0 +1,117 @@
+#ifndef AISDI_LINEAR_ALIGNEDALLOCATOR_H
+#define AISDI_LINEAR_ALIGNEDALLOCATOR_H
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace aisdi
+{
+
+// Allocator handing out blocks aligned to Alignment bytes (never less than alignof(Type)).
+// With HugePages set, blocks of at least one huge page are aligned to the huge page size and
+// advised for transparent huge pages, which cuts TLB misses on very large buffers.
+template <typename Type, std::size_t Alignment = 64, bool HugePages = false>
+class AlignedAllocator
+{
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+public:
+    using value_type = Type;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using is_always_equal = std::true_type;
+
+    template <typename Other>
+    struct rebind
+    {
+        using other = AlignedAllocator<Other, Alignment, HugePages>;
+    };
+
+    static constexpr std::size_t HugePageSize = std::size_t(2) << 20;
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename Other>
+    AlignedAllocator(const AlignedAllocator<Other, Alignment, HugePages>&) noexcept
+    {}
+
+    Type* allocate(size_type n)
+    {
+        if(n > max_size())
+            throw std::bad_array_new_length();
+        size_type bytes = n * sizeof(Type);
+        void* p = ::operator new(bytes, std::align_val_t(alignmentFor(bytes)));
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if(HugePages && bytes >= HugePageSize)
+            madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+        return static_cast<Type*>(p);
+    }
+
+    void deallocate(Type* p, size_type n) noexcept
+    {
+        size_type bytes = n * sizeof(Type);
+        ::operator delete(p, bytes, std::align_val_t(alignmentFor(bytes)));
+    }
+
+    // Aligned operator new rounds the size up to the alignment, so the largest alignment
+    // is kept free below SIZE_MAX; beyond it the rounded size would wrap.
+    static constexpr size_type max_size() noexcept
+    {
+        std::size_t largest = alignmentFor(HugePages ? HugePageSize : 0);
+        return (std::numeric_limits<size_type>::max() - largest) / sizeof(Type);
+    }
+
+    static constexpr std::size_t alignmentFor(size_type bytes)
+    {
+        if(HugePages && bytes >= HugePageSize)
+            return HugePageSize;
+        return Alignment > alignof(Type) ? Alignment : alignof(Type);
+    }
+
+    template <typename Other>
+    bool operator==(const AlignedAllocator<Other, Alignment, HugePages>&) const noexcept
+    {
+        return true;
+    }
+
+    template <typename Other>
+    bool operator!=(const AlignedAllocator<Other, Alignment, HugePages>&) const noexcept
+    {
+        return false;
+    }
+};
+
+// Alignment every block from Allocator is known to have; only AlignedAllocator promises
+// more than alignof(value_type).
+template <typename Allocator>
+struct AllocatorAlignment
+{
+    static constexpr std::size_t value = alignof(typename Allocator::value_type);
+};
+
+template <typename Type, std::size_t Alignment, bool HugePages>
+struct AllocatorAlignment<AlignedAllocator<Type, Alignment, HugePages>>
+{
+    static constexpr std::size_t value = AlignedAllocator<Type, Alignment, HugePages>::alignmentFor(0);
+};
+
+template <typename Type>
+using HugePageAllocator = AlignedAllocator<Type, 64, true>;
+
+// Arithmetic payloads get cache-line (and AVX-512) aligned buffers by default.
+template <typename Type>
+using DefaultAllocator = typename std::conditional<std::is_arithmetic<Type>::value,
+                                                   AlignedAllocator<Type, 64>,
+                                                   std::allocator<Type>>::type;
+
+}
+
+#endif // AISDI_LINEAR_ALIGNEDALLOCATOR_H
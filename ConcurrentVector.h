@@ -0,0 +1,341 @@
+#ifndef AISDI_LINEAR_CONCURRENTVECTOR_H
+#define AISDI_LINEAR_CONCURRENTVECTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "IndexedIterator.h"
+
+namespace aisdi
+{
+
+// Append-only vector that any number of threads may append to and read from at once.
+// append reserves an index with one fetch_add on a shared cursor, constructs the element
+// in place and publishes it; it never waits for other threads. Storage is laid out like
+// SegmentedVector (blocks of FirstBlockLength, 2*FirstBlockLength... elements) so growing
+// never relocates anything. A block is installed with a single compare-exchange; a thread
+// that loses the race frees its own block and uses the winner's.
+//
+// getSize() counts the published prefix of indices: every element below it is fully
+// constructed and safe to read from any thread. An append that throws after reserving its
+// index abandons it, and so does one whose block cannot be allocated (which abandons the
+// rest of that block too). Abandoned indices stay in the prefix but hold no element:
+// holds() tells them apart, and iterators step over them. Destruction and assignment
+// require that no other thread is using the vector.
+template <typename Type, std::size_t FirstBlockLength = 64>
+class ConcurrentVector
+{
+    static_assert(FirstBlockLength > 0 && (FirstBlockLength & (FirstBlockLength - 1)) == 0,
+                  "ConcurrentVector needs a power-of-two first block length");
+
+public:
+    using difference_type = std::ptrdiff_t;
+    using size_type = std::size_t;
+    using value_type = Type;
+    using pointer = Type*;
+    using reference = Type&;
+    using const_pointer = const Type*;
+    using const_reference = const Type&;
+
+    using ConstIterator = IndexedConstIterator<ConcurrentVector>;
+    using Iterator = IndexedIterator<ConcurrentVector>;
+    using iterator = Iterator;
+    using const_iterator = ConstIterator;
+
+private:
+    enum SlotState : unsigned char
+    {
+        Pending,
+        Ready,
+        Abandoned
+    };
+
+    struct Slot
+    {
+        alignas(Type) unsigned char bytes[sizeof(Type)];
+        std::atomic<unsigned char> state{Pending};
+
+        Type* object()
+        {
+            return std::launder(reinterpret_cast<Type*>(bytes));
+        }
+    };
+
+    static constexpr unsigned log2(size_type n)
+    {
+        return std::numeric_limits<size_type>::digits - 1 - __builtin_clzll(n);
+    }
+
+    static constexpr unsigned FirstShift = log2(FirstBlockLength);
+    static constexpr unsigned MaxBlocks = std::numeric_limits<size_type>::digits - FirstShift;
+
+    // Stands in for a block that could not be allocated; every index in it is abandoned.
+    inline static Slot LostBlock;
+
+    std::atomic<Slot*> blocks[MaxBlocks];
+    std::atomic<size_type> cursor;
+    mutable std::atomic<size_type> published;
+
+    static size_type blockLength(unsigned block)
+    {
+        return FirstBlockLength << block;
+    }
+
+    static unsigned blockOf(size_type index)
+    {
+        return log2(index + FirstBlockLength) - FirstShift;
+    }
+
+    Slot* ensureBlock(unsigned block)
+    {
+        if(block >= MaxBlocks)
+            throw std::length_error("ConcurrentVector cannot grow any further");
+        Slot* current = blocks[block].load(std::memory_order_acquire);
+        if(current == &LostBlock)
+            throw std::bad_alloc();
+        if(current != nullptr)
+            return current;
+        Slot* fresh = new Slot[blockLength(block)];
+        if(blocks[block].compare_exchange_strong(current, fresh, std::memory_order_acq_rel,
+                                                 std::memory_order_acquire))
+            return fresh;
+        delete[] fresh;
+        if(current == &LostBlock)
+            throw std::bad_alloc();
+        return current;
+    }
+
+    Slot& slot(size_type index) const
+    {
+        size_type shifted = index + FirstBlockLength;
+        unsigned block = log2(shifted) - FirstShift;
+        return blocks[block].load(std::memory_order_acquire)[shifted - blockLength(block)];
+    }
+
+    // Gives up a reserved index whose element will never be constructed. If its block is
+    // still missing, the whole block is marked lost and the cursor is moved past it when no
+    // other append has reserved an index since.
+    void abandon(size_type index)
+    {
+        size_type shifted = index + FirstBlockLength;
+        unsigned block = log2(shifted) - FirstShift;
+        Slot* storage = nullptr;
+        if(!blocks[block].compare_exchange_strong(storage, &LostBlock, std::memory_order_acq_rel,
+                                                  std::memory_order_acquire)
+           && storage != &LostBlock)
+        {
+            storage[shifted - blockLength(block)].state.store(Abandoned, std::memory_order_release);
+            return;
+        }
+        size_type expected = index + 1;
+        if(block + 1 < MaxBlocks)
+            cursor.compare_exchange_strong(expected, blockLength(block + 1) - FirstBlockLength,
+                                           std::memory_order_relaxed);
+    }
+
+    // The block may not be installed yet when its first index has only just been reserved.
+    SlotState stateOf(size_type index) const
+    {
+        size_type shifted = index + FirstBlockLength;
+        unsigned block = log2(shifted) - FirstShift;
+        Slot* storage = blocks[block].load(std::memory_order_acquire);
+        if(storage == nullptr)
+            return Pending;
+        if(storage == &LostBlock)
+            return Abandoned;
+        return SlotState(storage[shifted - blockLength(block)].state.load(std::memory_order_acquire));
+    }
+
+    void clear()
+    {
+        size_type reserved = cursor.load(std::memory_order_relaxed);
+        for(size_type i = 0; i < reserved; i++)
+            if(holds(i))
+                slot(i).object()->~Type();
+        for(unsigned block = 0; block < MaxBlocks; block++)
+        {
+            Slot* storage = blocks[block].exchange(nullptr, std::memory_order_relaxed);
+            if(storage != &LostBlock)
+                delete[] storage;
+        }
+        cursor.store(0, std::memory_order_relaxed);
+        published.store(0, std::memory_order_relaxed);
+    }
+
+public:
+    ConcurrentVector()
+        : cursor(0), published(0)
+    {
+        for(unsigned block = 0; block < MaxBlocks; block++)
+            blocks[block].store(nullptr, std::memory_order_relaxed);
+    }
+
+    ConcurrentVector(std::initializer_list<Type> l) : ConcurrentVector()
+    {
+        for(const Type& item : l)
+            append(item);
+    }
+
+    ConcurrentVector(const ConcurrentVector& other) : ConcurrentVector()
+    {
+        size_type n = other.getSize();
+        for(size_type i = 0; i < n; i++)
+            if(other.holds(i))
+                append(other[i]);
+    }
+
+    ConcurrentVector& operator=(const ConcurrentVector& other)
+    {
+        if(this == &other)
+            return *this;
+        clear();
+        size_type n = other.getSize();
+        for(size_type i = 0; i < n; i++)
+            if(other.holds(i))
+                append(other[i]);
+        return *this;
+    }
+
+    ~ConcurrentVector()
+    {
+        clear();
+    }
+
+    bool isEmpty() const
+    {
+        return getSize() == 0;
+    }
+
+    // Length of the published prefix, abandoned indices included. Elements appended
+    // concurrently past a slot that is still being constructed are counted once that slot
+    // is published.
+    size_type getSize() const
+    {
+        size_type n = published.load(std::memory_order_acquire);
+        size_type reserved = cursor.load(std::memory_order_acquire);
+        size_type end = n;
+        while(end < reserved && stateOf(end) != Pending)
+            end++;
+        // Other readers advance the same prefix; keeping the larger value is enough.
+        while(end > n && !published.compare_exchange_weak(n, end, std::memory_order_acq_rel))
+            ;
+        return end > n ? end : n;
+    }
+
+    // Allocates the blocks for the first n elements up front, so appends below n never
+    // allocate. Safe to call concurrently with append.
+    void reserve(size_type n)
+    {
+        if(n == 0)
+            return;
+        for(unsigned block = 0; block <= blockOf(n - 1); block++)
+            ensureBlock(block);
+    }
+
+    size_type append(const Type& item)
+    {
+        return emplaceBack(item);
+    }
+
+    size_type append(Type&& item)
+    {
+        return emplaceBack(std::move(item));
+    }
+
+    // Returns the index of the new element; it is readable by other threads once
+    // getSize() exceeds that index. If construction or allocation throws, the index is
+    // abandoned before the exception propagates.
+    template <typename... Args>
+    size_type emplaceBack(Args&&... args)
+    {
+        size_type index = cursor.fetch_add(1, std::memory_order_relaxed);
+        size_type shifted = index + FirstBlockLength;
+        unsigned block = log2(shifted) - FirstShift;
+        try
+        {
+            Slot* storage = ensureBlock(block);
+            Slot& target = storage[shifted - blockLength(block)];
+            new (target.bytes) Type(std::forward<Args>(args)...);
+            target.state.store(Ready, std::memory_order_release);
+        }
+        catch(...)
+        {
+            abandon(index);
+            throw;
+        }
+        // The first append into a block installs the next one, so later appends seldom race.
+        // It is only a head start: whoever needs the block allocates it otherwise.
+        if(shifted == blockLength(block) && block + 1 < MaxBlocks)
+        {
+            try
+            {
+                ensureBlock(block + 1);
+            }
+            catch(const std::bad_alloc&)
+            {}
+        }
+        return index;
+    }
+
+    // False for abandoned indices and for those not published yet.
+    bool holds(size_type index) const
+    {
+        return stateOf(index) == Ready;
+    }
+
+    // Valid for indices below getSize() that hold an element, and for indices returned by
+    // this thread's appends.
+    reference operator[](size_type index)
+    {
+        return *slot(index).object();
+    }
+
+    const_reference operator[](size_type index) const
+    {
+        return *slot(index).object();
+    }
+
+    iterator begin()
+    {
+        return iterator(cbegin());
+    }
+
+    iterator end()
+    {
+        return iterator(cend());
+    }
+
+    const_iterator cbegin() const
+    {
+        size_type size = getSize();
+        size_type first = 0;
+        while(first < size && !holds(first))
+            first++;
+        return ConstIterator(first, this);
+    }
+
+    // Fixed at the published size when called; elements appended later are not visited.
+    const_iterator cend() const
+    {
+        return ConstIterator(getSize(), this);
+    }
+
+    const_iterator begin() const
+    {
+        return cbegin();
+    }
+
+    const_iterator end() const
+    {
+        return cend();
+    }
+};
+
+}
+
+#endif // AISDI_LINEAR_CONCURRENTVECTOR_H
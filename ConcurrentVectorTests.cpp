@@ -0,0 +1,140 @@
+#include <ConcurrentVector.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+template <typename T>
+using LinearCollection = aisdi::ConcurrentVector<T, 4>;
+
+using std::begin;
+using std::end;
+
+BOOST_AUTO_TEST_SUITE(ConcurrentVectorTests)
+
+namespace
+{
+
+struct Record
+{
+  std::uint64_t id;
+  std::uint64_t check;
+
+  explicit Record(std::uint64_t i) : id(i), check(~i)
+  {}
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenAppending_ThenIndicesAreReturnedInOrder)
+{
+  LinearCollection<std::string> collection;
+
+  BOOST_CHECK(collection.isEmpty());
+  for(int i = 0; i < 20; ++i)
+    BOOST_CHECK_EQUAL(collection.append(std::to_string(i)), static_cast<std::size_t>(i));
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 20);
+  BOOST_CHECK_EQUAL(collection[13], "13");
+  BOOST_CHECK_EQUAL(*(begin(collection) + 7), "7");
+  BOOST_CHECK_EQUAL(end(collection) - begin(collection), 20);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenCopying_ThenPublishedItemsAreCopied)
+{
+  LinearCollection<int> collection = { 1, 2, 3, 4, 5 };
+  const int* third = &collection[2];
+
+  LinearCollection<int> copy{collection};
+  collection.append(6);
+
+  BOOST_CHECK(&collection[2] == third);
+  BOOST_CHECK_EQUAL(copy.getSize(), 5);
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(copy), end(copy), begin(collection), end(collection) - 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenThrowingConstructor_WhenAppending_ThenIndexIsAbandonedAndSkipped)
+{
+  struct Fragile
+  {
+    int value;
+
+    explicit Fragile(int v) : value(v)
+    {
+      if(v < 0)
+        throw std::runtime_error("negative");
+    }
+  };
+  LinearCollection<Fragile> collection;
+
+  collection.emplaceBack(1);
+  BOOST_CHECK_THROW(collection.emplaceBack(-1), std::runtime_error);
+  BOOST_CHECK_EQUAL(collection.emplaceBack(2), 2);
+  BOOST_CHECK_EQUAL(collection.emplaceBack(3), 3);
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 4);
+  BOOST_CHECK(!collection.holds(1));
+  BOOST_CHECK_THROW(*(begin(collection) + 1), std::out_of_range);
+  std::vector<int> values;
+  for(const Fragile& item : collection)
+    values.push_back(item.value);
+  const int expected[] = { 1, 2, 3 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(values.begin(), values.end(), begin(expected), end(expected));
+  BOOST_CHECK_EQUAL((--end(collection))->value, 3);
+  BOOST_CHECK_EQUAL((--(++begin(collection)))->value, 1);
+
+  LinearCollection<Fragile> copy{collection};
+  BOOST_CHECK_EQUAL(copy.getSize(), 3);
+  BOOST_CHECK_EQUAL(copy[1].value, 2);
+}
+
+BOOST_AUTO_TEST_CASE(GivenManyThreads_WhenAppendingConcurrently_ThenEveryItemIsStoredOnce)
+{
+  const int threads = 4;
+  const int perThread = 20000;
+  LinearCollection<Record> collection;
+  std::atomic<bool> done{false};
+  std::atomic<bool> tornRead{false};
+
+  std::thread reader([&]
+  {
+    while(!done.load())
+      for(const Record& record : collection)
+        if(record.check != ~record.id)
+          tornRead = true;
+  });
+
+  std::vector<std::thread> writers;
+  std::vector<std::vector<std::size_t>> indices(threads);
+  for(int t = 0; t < threads; ++t)
+    writers.emplace_back([&, t]
+    {
+      for(int i = 0; i < perThread; ++i)
+        indices[t].push_back(collection.emplaceBack(std::uint64_t(t) * perThread + i));
+    });
+  for(std::thread& writer : writers)
+    writer.join();
+  done = true;
+  reader.join();
+
+  BOOST_CHECK(!tornRead);
+  BOOST_REQUIRE_EQUAL(collection.getSize(), threads * perThread);
+  std::vector<bool> seen(threads * perThread, false);
+  for(int t = 0; t < threads; ++t)
+    for(int i = 0; i < perThread; ++i)
+    {
+      const Record& record = collection[indices[t][i]];
+      BOOST_REQUIRE_EQUAL(record.id, std::uint64_t(t) * perThread + i);
+      seen[record.id] = true;
+    }
+  BOOST_CHECK(std::all_of(seen.begin(), seen.end(), [](bool s) { return s; }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
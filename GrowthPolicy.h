@@ -0,0 +1,94 @@
+#ifndef AISDI_LINEAR_GROWTHPOLICY_H
+#define AISDI_LINEAR_GROWTHPOLICY_H
+
+#include <cstddef>
+
+namespace aisdi
+{
+
+// Growth policies pick Vector's next capacity once the current one (never zero) cannot hold
+// required elements. Any default-constructible functor with this call signature can be
+// used; Vector never goes below required whatever the policy returns.
+
+struct DoublingGrowth
+{
+    std::size_t operator()(std::size_t capacity, std::size_t required) const
+    {
+        return capacity * 2 > required ? capacity * 2 : required;
+    }
+};
+
+struct OneAndHalfGrowth
+{
+    std::size_t operator()(std::size_t capacity, std::size_t required) const
+    {
+        std::size_t grown = capacity + capacity / 2 + 1;
+        return grown > required ? grown : required;
+    }
+};
+
+template <std::size_t Increment>
+struct FixedIncrementGrowth
+{
+    static_assert(Increment > 0, "FixedIncrementGrowth needs a non-zero increment");
+
+    std::size_t operator()(std::size_t capacity, std::size_t required) const
+    {
+        return capacity + Increment > required ? capacity + Increment : required;
+    }
+};
+
+// Doubles until a single step would add more than MaxStep elements, then grows by MaxStep.
+// Bounds the transient memory spike of reallocating very large buffers.
+template <std::size_t MaxStep>
+struct CappedDoublingGrowth
+{
+    static_assert(MaxStep > 0, "CappedDoublingGrowth needs a non-zero step");
+
+    std::size_t operator()(std::size_t capacity, std::size_t required) const
+    {
+        std::size_t grown = capacity + (capacity < MaxStep ? capacity : MaxStep);
+        return grown > required ? grown : required;
+    }
+};
+
+// Statistics policies decide whether Vector counts what its growth costs. NoGrowthStatistics
+// is empty and, being a base of Vector, takes no space; CountingGrowthStatistics enables
+// reallocationCount() and bytesMoved().
+
+struct NoGrowthStatistics
+{
+    static constexpr bool enabled = false;
+
+    void recordReallocation() {}
+    void recordMove(std::size_t) {}
+    void reset() {}
+};
+
+struct CountingGrowthStatistics
+{
+    static constexpr bool enabled = true;
+
+    std::size_t reallocations = 0;
+    std::size_t movedBytes = 0;
+
+    void recordReallocation()
+    {
+        reallocations++;
+    }
+
+    void recordMove(std::size_t bytes)
+    {
+        movedBytes += bytes;
+    }
+
+    void reset()
+    {
+        reallocations = 0;
+        movedBytes = 0;
+    }
+};
+
+}
+
+#endif // AISDI_LINEAR_GROWTHPOLICY_H
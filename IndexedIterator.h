@@ -0,0 +1,298 @@
+#ifndef AISDI_LINEAR_INDEXEDITERATOR_H
+#define AISDI_LINEAR_INDEXEDITERATOR_H
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace aisdi
+{
+
+// Containers whose indices below getSize() may hold no element (ConcurrentVector after a
+// failed append) provide holds(index).
+template <typename Container, typename = void>
+struct HasHoles : std::false_type
+{};
+
+template <typename Container>
+struct HasHoles<Container, std::void_t<decltype(std::declval<const Container&>().holds(std::size_t()))>>
+    : std::true_type
+{};
+
+// Checked random-access iterators for containers that are indexed rather than walked by
+// pointer. The container provides getSize() and operator[]; the iterators follow the
+// conventions of Vector's (same throwing behaviour at both ends). Over a container with
+// holes, ++ and -- step over empty indices and iterators with only holes between them
+// compare equal; arithmetic and ordering still count indices.
+template <typename Container>
+class IndexedConstIterator
+{
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = typename Container::value_type;
+    using difference_type = typename Container::difference_type;
+    using pointer = typename Container::const_pointer;
+    using reference = typename Container::const_reference;
+    using size_type = typename Container::size_type;
+
+protected:
+    const Container *Cont;
+    size_type currEl;
+
+public:
+    explicit IndexedConstIterator()
+    {
+        Cont = NULL;
+        currEl = 0;
+    }
+
+    IndexedConstIterator(size_type currEll, const Container* Contt)
+    {
+        currEl = currEll;
+        Cont = Contt;
+    }
+
+    size_type index() const
+    {
+        return currEl;
+    }
+
+    reference operator*() const
+    {
+        if(Cont->getSize() == currEl)
+            throw std::out_of_range("Cannot shell refer to value while pointing to the end sentinel");
+        if constexpr (HasHoles<Container>::value)
+            if(!Cont->holds(currEl))
+                throw std::out_of_range("Cannot refer to an index that holds no element");
+        return (*Cont)[currEl];
+    }
+
+    pointer operator->() const
+    {
+        return &(operator*());
+    }
+
+    reference operator[](difference_type d) const
+    {
+        return *(*this + d);
+    }
+
+    IndexedConstIterator& operator++()
+    {
+        if(Cont->getSize() < currEl+1)
+            throw std::out_of_range("Cannot increment beyond end sentinel");
+        currEl++;
+        if constexpr (HasHoles<Container>::value)
+        {
+            size_type size = Cont->getSize();
+            while(currEl < size && !Cont->holds(currEl))
+                currEl++;
+        }
+        return *this;
+    }
+
+    IndexedConstIterator operator++(int)
+    {
+        IndexedConstIterator cur = *this;
+        ++*this;
+        return cur;
+    }
+
+    IndexedConstIterator& operator--()
+    {
+        if(currEl == 0)
+            throw std::out_of_range("Cannot decrement before first");
+        if constexpr (HasHoles<Container>::value)
+        {
+            size_type prev = currEl - 1;
+            while(prev > 0 && !Cont->holds(prev))
+                prev--;
+            if(!Cont->holds(prev))
+                throw std::out_of_range("Cannot decrement before first");
+            currEl = prev;
+        }
+        else
+            currEl--;
+        return *this;
+    }
+
+    IndexedConstIterator operator--(int)
+    {
+        IndexedConstIterator cur = *this;
+        --*this;
+        return cur;
+    }
+
+    IndexedConstIterator& operator+=(difference_type d)
+    {
+        currEl += d;
+        return *this;
+    }
+
+    IndexedConstIterator& operator-=(difference_type d)
+    {
+        currEl -= d;
+        return *this;
+    }
+
+    IndexedConstIterator operator+(difference_type d) const
+    {
+        IndexedConstIterator result = *this;
+        return result += d;
+    }
+
+    friend IndexedConstIterator operator+(difference_type d, const IndexedConstIterator& it)
+    {
+        return it + d;
+    }
+
+    IndexedConstIterator operator-(difference_type d) const
+    {
+        IndexedConstIterator result = *this;
+        return result -= d;
+    }
+
+    difference_type operator-(const IndexedConstIterator& other) const
+    {
+        return static_cast<difference_type>(currEl) - static_cast<difference_type>(other.currEl);
+    }
+
+    bool operator==(const IndexedConstIterator& other) const
+    {
+        if(Cont != other.Cont)
+            return false;
+        if constexpr (HasHoles<Container>::value)
+        {
+            size_type from = currEl < other.currEl ? currEl : other.currEl;
+            size_type to = currEl < other.currEl ? other.currEl : currEl;
+            for(; from < to; from++)
+                if(Cont->holds(from))
+                    return false;
+            return true;
+        }
+        return currEl == other.currEl;
+    }
+
+    bool operator!=(const IndexedConstIterator& other) const
+    {
+        return !(*this == other);
+    }
+
+    bool operator<(const IndexedConstIterator& other) const
+    {
+        return currEl < other.currEl;
+    }
+
+    bool operator>(const IndexedConstIterator& other) const
+    {
+        return other < *this;
+    }
+
+    bool operator<=(const IndexedConstIterator& other) const
+    {
+        return !(other < *this);
+    }
+
+    bool operator>=(const IndexedConstIterator& other) const
+    {
+        return !(*this < other);
+    }
+};
+
+template <typename Container>
+class IndexedIterator : public IndexedConstIterator<Container>
+{
+    using ConstIterator = IndexedConstIterator<Container>;
+
+public:
+    using pointer = typename Container::pointer;
+    using reference = typename Container::reference;
+    using difference_type = typename ConstIterator::difference_type;
+
+    explicit IndexedIterator()
+    {}
+
+    IndexedIterator(const ConstIterator& other)
+        : ConstIterator(other)
+    {}
+
+    IndexedIterator& operator++()
+    {
+        ConstIterator::operator++();
+        return *this;
+    }
+
+    IndexedIterator operator++(int)
+    {
+        auto result = *this;
+        ConstIterator::operator++();
+        return result;
+    }
+
+    IndexedIterator& operator--()
+    {
+        ConstIterator::operator--();
+        return *this;
+    }
+
+    IndexedIterator operator--(int)
+    {
+        auto result = *this;
+        ConstIterator::operator--();
+        return result;
+    }
+
+    IndexedIterator& operator+=(difference_type d)
+    {
+        ConstIterator::operator+=(d);
+        return *this;
+    }
+
+    IndexedIterator& operator-=(difference_type d)
+    {
+        ConstIterator::operator-=(d);
+        return *this;
+    }
+
+    IndexedIterator operator+(difference_type d) const
+    {
+        return ConstIterator::operator+(d);
+    }
+
+    friend IndexedIterator operator+(difference_type d, const IndexedIterator& it)
+    {
+        return it + d;
+    }
+
+    IndexedIterator operator-(difference_type d) const
+    {
+        return ConstIterator::operator-(d);
+    }
+
+    difference_type operator-(const ConstIterator& other) const
+    {
+        return ConstIterator::operator-(other);
+    }
+
+    reference operator*() const
+    {
+        // ugly cast, yet reduces code duplication.
+        return const_cast<reference>(ConstIterator::operator*());
+    }
+
+    pointer operator->() const
+    {
+        return &(operator*());
+    }
+
+    reference operator[](difference_type d) const
+    {
+        return *(*this + d);
+    }
+};
+
+}
+
+#endif // AISDI_LINEAR_INDEXEDITERATOR_H
@@ -0,0 +1,27 @@
+#ifndef AISDI_LINEAR_ITERATORPOLICY_H
+#define AISDI_LINEAR_ITERATORPOLICY_H
+
+namespace aisdi
+{
+
+// Selects whether container iterators validate every step and dereference. Checked
+// iterators throw std::out_of_range when moved past either end or dereferenced at end();
+// unchecked ones reduce to bare pointer (Vector) or link (LinkedList) walks, which lets
+// tight loops over them vectorize. Misusing an unchecked iterator is undefined behaviour.
+struct CheckedIterators
+{
+    static constexpr bool checked = true;
+};
+
+struct UncheckedIterators
+{
+    static constexpr bool checked = false;
+};
+
+// Checks are on by default whatever the build settings, so one spelling always names one
+// type; code that wants bare walks names UncheckedIterators explicitly.
+using DefaultIteratorPolicy = CheckedIterators;
+
+}
+
+#endif // AISDI_LINEAR_ITERATORPOLICY_H
@@ -2,14 +2,24 @@
 #define AISDI_LINEAR_LINKEDLIST_H
 
 #include <cstddef>
+#include <functional>
 #include <initializer_list>
+#include <memory>
+#include <memory_resource>
 #include <stdexcept>
+#include <utility>
+
+#include "IteratorPolicy.h"
 
 namespace aisdi
 {
 
-    template <typename Type>
-    class LinkedList
+    // Nodes are allocated through Allocator rebound to the node type. The allocator is a
+    // private base so that stateless allocators take no space. IteratorPolicy (see
+    // IteratorPolicy.h) decides whether iterators check for the sentinels.
+    template <typename Type, typename Allocator = std::allocator<Type>,
+              typename IteratorPolicy = DefaultIteratorPolicy>
+    class LinkedList : private Allocator
     {
     public:
         using difference_type = std::ptrdiff_t;
@@ -19,6 +29,7 @@ namespace aisdi
         using reference = Type&;
         using const_pointer = const Type*;
         using const_reference = const Type&;
+        using allocator_type = Allocator;
 
         class ConstIterator;
         class Iterator;
@@ -26,106 +37,297 @@ namespace aisdi
         using const_iterator = ConstIterator;
 
     private:
-        struct node{
+        // The sentinels are bare links kept inside the list object, so an empty list owns
+        // no memory and Type needs no default constructor. Element nodes add the payload.
+        struct link{
+            link *prev;
+            link *next;
+        };
+
+        struct node : link{
             const Type obj;
-            node *prev;
-            node *next;
 
-            node(const Type &A) :obj(A)
+            template <typename... Args>
+            explicit node(Args&&... args) :link{NULL, NULL}, obj(std::forward<Args>(args)...)
             {
-              next = NULL;
-              prev = NULL;
-
             }
 
             ~node()
             {
-              next = NULL;
-              prev = NULL;
+              this->next = NULL;
+              this->prev = NULL;
             }
 
         };
 
-        node *first;
-        node *last;
-        int length;
+        using AllocTraits = std::allocator_traits<Allocator>;
+        using NodeAllocator = typename AllocTraits::template rebind_alloc<node>;
+        using NodeTraits = std::allocator_traits<NodeAllocator>;
 
-    public:
-        LinkedList()
-        {
-          first = new node(Type());
-          last = new node(Type());
-          first->prev = NULL;
-          first->next = last;
-          last->prev = first;
-          last->next = NULL;
+        link first;
+        link last;
+        size_type length;
+
+        Allocator& alloc()
+        {
+          return *this;
+        }
+
+        const Allocator& alloc() const
+        {
+          return *this;
+        }
+
+        template <typename... Args>
+        node* createNode(Args&&... args)
+        {
+          NodeAllocator nodeAllocator(alloc());
+          node* newNode = NodeTraits::allocate(nodeAllocator, 1);
+          try
+          {
+            NodeTraits::construct(nodeAllocator, newNode, std::forward<Args>(args)...);
+          }
+          catch(...)
+          {
+            NodeTraits::deallocate(nodeAllocator, newNode, 1);
+            throw;
+          }
+          return newNode;
+        }
+
+        void destroyNode(node* oldNode)
+        {
+          NodeAllocator nodeAllocator(alloc());
+          NodeTraits::destroy(nodeAllocator, oldNode);
+          NodeTraits::deallocate(nodeAllocator, oldNode, 1);
+        }
+
+        // A null-terminated chain of nodes; prev links are valid after the head.
+        struct run
+        {
+          node* head;
+          node* tail;
+        };
+
+        // Joins piece after the end of to.
+        static void appendRun(run& to, run piece)
+        {
+          if(piece.head == NULL)
+            return;
+          if(to.head == NULL)
+          {
+            to = piece;
+            return;
+          }
+          to.tail->next = piece.head;
+          piece.head->prev = to.tail;
+          to.tail = piece.tail;
+        }
+
+        // Stable merge of two chains; prev links are set as nodes are taken. If cmp throws,
+        // left ends up holding every node of both chains in no particular order and right
+        // is emptied.
+        template <typename Compare>
+        static run mergeRuns(run& left, run& right, Compare& cmp)
+        {
+          if(left.head == NULL)
+            return right;
+          if(right.head == NULL)
+            return left;
+          node* l = left.head;
+          node* r = right.head;
+          run merged{NULL, NULL};
+          try
+          {
+            if(cmp(r->obj, l->obj))
+            {
+              merged = run{r, r};
+              r = static_cast<node*>(r->next);
+            }
+            else
+            {
+              merged = run{l, l};
+              l = static_cast<node*>(l->next);
+            }
+            while(l != NULL && r != NULL)
+            {
+              if(cmp(r->obj, l->obj))
+              {
+                merged.tail->next = r;
+                r->prev = merged.tail;
+                merged.tail = r;
+                r = static_cast<node*>(r->next);
+              }
+              else
+              {
+                merged.tail->next = l;
+                l->prev = merged.tail;
+                merged.tail = l;
+                l = static_cast<node*>(l->next);
+              }
+            }
+          }
+          catch(...)
+          {
+            if(l != NULL)
+              appendRun(merged, run{l, left.tail});
+            if(r != NULL)
+              appendRun(merged, run{r, right.tail});
+            merged.tail->next = NULL;
+            left = merged;
+            right = run{NULL, NULL};
+            throw;
+          }
+          if(l != NULL)
+            appendRun(merged, run{l, left.tail});
+          if(r != NULL)
+            appendRun(merged, run{r, right.tail});
+          return merged;
+        }
+
+        // Hangs a whole chain between the sentinels.
+        void linkRun(run chain)
+        {
+          first.next = chain.head;
+          chain.head->prev = &first;
+          chain.tail->next = &last;
+          last.prev = chain.tail;
+        }
+
+        void resetLinks()
+        {
+          first.prev = NULL;
+          first.next = &last;
+          last.prev = &first;
+          last.next = NULL;
           length = 0;
         }
 
-        LinkedList(std::initializer_list<Type> l) :LinkedList()
+        // Takes over other's nodes by relinking the ends; this must be empty.
+        void takeNodes(LinkedList& other)
+        {
+          if(other.isEmpty())
+            return;
+          first.next = other.first.next;
+          first.next->prev = &first;
+          last.prev = other.last.prev;
+          last.prev->next = &last;
+          length = other.length;
+          other.resetLinks();
+        }
+
+        void linkBefore(link* nextNode, node* newNode)
+        {
+          link* prevNode = nextNode->prev;
+          newNode->next = nextNode;
+          newNode->prev = prevNode;
+          prevNode->next = newNode;
+          nextNode->prev = newNode;
+          length++;
+        }
+
+    public:
+        LinkedList() noexcept(noexcept(Allocator())) :LinkedList(Allocator())
+        {
+        }
+
+        explicit LinkedList(const Allocator& allocator) noexcept :Allocator(allocator)
+        {
+          resetLinks();
+        }
+
+        LinkedList(std::initializer_list<Type> l, const Allocator& allocator = Allocator())
+          :LinkedList(allocator)
         {
           for(auto it = l.begin(); it != (l.end()); ++it)
             append(*it);
         }
 
-        LinkedList(const LinkedList& other) :LinkedList()
+        LinkedList(const LinkedList& other)
+          :LinkedList(AllocTraits::select_on_container_copy_construction(other.alloc()))
         {
           for(auto it = other.begin(); it != other.end(); ++it)
             append(*it);
         }
 
-        LinkedList(LinkedList&& other) :LinkedList()
+        // Relinks other's nodes; allocates nothing and leaves other empty.
+        LinkedList(LinkedList&& other) noexcept :LinkedList(other.alloc())
         {
-            auto firstTemp = first;
-            auto lengthTemp = length;
-            auto lastTemp = last;
-
-            first = other.first;
-            length = other.length;
-            last = other.last;
-
-            other.first = firstTemp;
-            other.length = lengthTemp;
-            other.last = lastTemp;
+            takeNodes(other);
         }
 
         ~LinkedList()
         {
             erase(begin(), end());
-            delete first;
-            delete last;
         }
 
         LinkedList& operator=(const LinkedList& other)
         {
+          if(this == &other)
+            return *this;
+          // Our nodes go back to the allocator that made them before it can be replaced.
           erase(begin(), end());
+          if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+            alloc() = other.alloc();
           for(auto it = other.begin(); it != other.end(); ++it)
             append(*it);
           return *this;
         }
 
         LinkedList& operator=(LinkedList&& other)
+          noexcept(AllocTraits::propagate_on_container_move_assignment::value
+                   || AllocTraits::is_always_equal::value)
         {
+            if(this == &other)
+              return *this;
             erase(begin(), end());
 
-            auto firstTemp = first;
-            auto lengthTemp = length;
-            auto lastTemp = last;
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+            {
+              alloc() = other.alloc();
+            }
+            else if(alloc() != other.alloc())
+            {
+              // Nodes from an unequal allocator cannot be adopted, so their payloads are copied.
+              for(auto it = other.begin(); it != other.end(); ++it)
+                append(*it);
+              other.erase(other.begin(), other.end());
+              return *this;
+            }
+            takeNodes(other);
+            return *this;
+        }
 
-            first = other.first;
-            length = other.length;
-            last = other.last;
+        // Exchanges the nodes by relinking both ends; allocates nothing. Allocators are
+        // exchanged only if they propagate on swap; otherwise they must compare equal.
+        void swap(LinkedList& other) noexcept
+        {
+            if(this == &other)
+              return;
+            if constexpr (AllocTraits::propagate_on_container_swap::value)
+            {
+              using std::swap;
+              swap(alloc(), other.alloc());
+            }
+            LinkedList temp(alloc());
+            temp.takeNodes(*this);
+            takeNodes(other);
+            other.takeNodes(temp);
+        }
 
-            other.first = firstTemp;
-            other.length = lengthTemp;
-            other.last = lastTemp;
+        friend void swap(LinkedList& a, LinkedList& b) noexcept
+        {
+            a.swap(b);
+        }
 
-            return *this;
+        allocator_type getAllocator() const
+        {
+            return alloc();
         }
 
         bool isEmpty() const
         {
-            return first-> next == last;
+            return first.next == &last;
         }
 
         size_type getSize() const
@@ -135,38 +337,52 @@ namespace aisdi
 
         void append(const Type& item)
         {
-          node* newNode = new node(item);
-          node* curr = last->prev;
-          last->prev = newNode;
-          newNode->next = last;
-          newNode->prev = curr;
-          curr->next = newNode;
-          length++;
+          linkBefore(&last, createNode(item));
+        }
+
+        void append(Type&& item)
+        {
+          linkBefore(&last, createNode(std::move(item)));
         }
 
         void prepend(const Type& item)
         {
-          node* newNode = new node(item);
-          node* curr = first->next;
-          first->next = newNode;
-          newNode->next = curr;
-          newNode->prev = first;
-          curr->prev = newNode;
-          length++;
+          linkBefore(first.next, createNode(item));
+        }
+
+        void prepend(Type&& item)
+        {
+          linkBefore(first.next, createNode(std::move(item)));
         }
 
         void insert(const const_iterator& insertPosition, const Type& item)
         {
           //Czy sprawdzać warunki i używać append/prepend
           //Nie ma takiej potrzeby, mamy 2 sentinele
+          linkBefore(insertPosition.currNode, createNode(item));
+        }
 
-          node* newNode = new node(item);
-          node* prevNode = insertPosition.currNode->prev;
-          newNode->next = insertPosition.currNode;
-          newNode->prev = prevNode;
-          prevNode->next = newNode;
-          (insertPosition.currNode)->prev = newNode;
-          length++;
+        void insert(const const_iterator& insertPosition, Type&& item)
+        {
+          linkBefore(insertPosition.currNode, createNode(std::move(item)));
+        }
+
+        template <typename... Args>
+        void emplaceBack(Args&&... args)
+        {
+          linkBefore(&last, createNode(std::forward<Args>(args)...));
+        }
+
+        template <typename... Args>
+        void emplaceFront(Args&&... args)
+        {
+          linkBefore(first.next, createNode(std::forward<Args>(args)...));
+        }
+
+        template <typename... Args>
+        void emplace(const const_iterator& insertPosition, Args&&... args)
+        {
+          linkBefore(insertPosition.currNode, createNode(std::forward<Args>(args)...));
         }
 
         Type popFirst()
@@ -195,7 +411,7 @@ namespace aisdi
           --length;
           possition.currNode->next->prev = possition.currNode->prev;
           possition.currNode->prev->next= possition.currNode->next;
-          delete possition.currNode;
+          destroyNode(static_cast<node*>(possition.currNode));
         }
 
         void erase(const const_iterator& firstIncluded, const const_iterator& lastExcluded)
@@ -209,6 +425,116 @@ namespace aisdi
           }
         }
 
+        // Bottom-up merge sort that only relinks nodes: payloads are never copied or moved
+        // and iterators stay valid. Runs of 1, 2, 4... nodes are kept in bins like the digits
+        // of a binary counter, which needs no extra memory. Stable. If cmp throws, every
+        // element stays in the list but their order is unspecified.
+        template <typename Compare = std::less<>>
+        void sort(Compare cmp = Compare())
+        {
+          if(length < 2)
+            return;
+          node* lastNode = static_cast<node*>(last.prev);
+          lastNode->next = NULL;
+          node* pending = static_cast<node*>(first.next);
+          run bins[64] = {};
+          run sorted{NULL, NULL};
+          try
+          {
+            while(pending != NULL)
+            {
+              run carry{pending, pending};
+              pending = static_cast<node*>(pending->next);
+              carry.head->next = NULL;
+              int bin = 0;
+              // Older runs hold earlier elements, so they merge in on the left.
+              for(; bins[bin].head != NULL; bin++)
+              {
+                carry = mergeRuns(bins[bin], carry, cmp);
+                bins[bin] = run{NULL, NULL};
+              }
+              bins[bin] = carry;
+            }
+            for(int bin = 0; bin < 64; bin++)
+            {
+              sorted = mergeRuns(bins[bin], sorted, cmp);
+              bins[bin] = run{NULL, NULL};
+            }
+          }
+          catch(...)
+          {
+            // Every node is still in exactly one run; put them all back, order not kept.
+            for(int bin = 0; bin < 64; bin++)
+              appendRun(sorted, bins[bin]);
+            if(pending != NULL)
+              appendRun(sorted, run{pending, lastNode});
+            linkRun(sorted);
+            throw;
+          }
+          linkRun(sorted);
+        }
+
+        // sort() is already stable; kept for symmetry with Vector.
+        template <typename Compare = std::less<>>
+        void stableSort(Compare cmp = Compare())
+        {
+          sort(cmp);
+        }
+
+        // Unlinks and frees every element pred accepts in one walk; returns how many went.
+        template <typename Predicate>
+        size_type removeIf(Predicate pred)
+        {
+          size_type removed = 0;
+          for(link* curr = first.next; curr != &last;)
+          {
+            link* next = curr->next;
+            if(pred(static_cast<node*>(curr)->obj))
+            {
+              curr->prev->next = next;
+              next->prev = curr->prev;
+              destroyNode(static_cast<node*>(curr));
+              --length;
+              ++removed;
+            }
+            curr = next;
+          }
+          return removed;
+        }
+
+        // value may live in one of our own nodes; that node stays linked until the walk is
+        // over and nothing compares against it any more.
+        size_type removeValue(const Type& value)
+        {
+          size_type removed = 0;
+          node* holder = NULL;
+          for(link* curr = first.next; curr != &last;)
+          {
+            link* next = curr->next;
+            node* item = static_cast<node*>(curr);
+            if(&item->obj == &value)
+              holder = item;
+            else if(item->obj == value)
+            {
+              curr->prev->next = next;
+              next->prev = curr->prev;
+              destroyNode(item);
+              --length;
+              ++removed;
+            }
+            curr = next;
+          }
+          if(holder)
+          {
+            holder->prev->next = holder->next;
+            holder->next->prev = holder->prev;
+            destroyNode(holder);
+            --length;
+            ++removed;
+          }
+          return removed;
+        }
+
         iterator begin()
         {
 
@@ -222,15 +548,12 @@ namespace aisdi
 
         const_iterator cbegin() const
         {
-          if(isEmpty())
-            return  ConstIterator(last);
-          else
-            return ConstIterator(first->next);
+          return ConstIterator(first.next);
         }
 
         const_iterator cend() const
         {
-          return ConstIterator(last);;
+          return ConstIterator(const_cast<link*>(&last));
         }
 
         const_iterator begin() const
@@ -244,8 +567,8 @@ namespace aisdi
         }
     };
 
-    template <typename Type>
-    class LinkedList<Type>::ConstIterator
+    template <typename Type, typename Allocator, typename IteratorPolicy>
+    class LinkedList<Type, Allocator, IteratorPolicy>::ConstIterator
     {
     public:
         using iterator_category = std::bidirectional_iterator_tag;
@@ -254,40 +577,39 @@ namespace aisdi
         using pointer = typename LinkedList::const_pointer;
         using reference = typename LinkedList::const_reference;
 
-        node* currNode;
+        link* currNode;
 
         explicit ConstIterator()
         {
           currNode = NULL;
         }
-        ConstIterator(node* n)
+        ConstIterator(link* n)
         {
           currNode = n;
         }
 
         reference operator*() const
         {
-          if(currNode->next != NULL)
-            return currNode->obj;
-          else
-            throw std::out_of_range("Can't shell when pointing to end");
+          if constexpr (IteratorPolicy::checked)
+            if(currNode->next == NULL)
+              throw std::out_of_range("Can't shell when pointing to end");
+          return static_cast<const node*>(currNode)->obj;
         }
 
         ConstIterator& operator++()
         {
-          if(currNode->next != NULL)
-          {
-            currNode = currNode->next;
-            return *this;
-          }
-          else
-            throw std::out_of_range("Cannot increment when pointing to end");
+          if constexpr (IteratorPolicy::checked)
+            if(currNode->next == NULL)
+              throw std::out_of_range("Cannot increment when pointing to end");
+          currNode = currNode->next;
+          return *this;
         }
 
         ConstIterator operator++(int)
         {
-          if(currNode->next == NULL)
-            throw std::out_of_range("Can't increment when pointing to end");
+          if constexpr (IteratorPolicy::checked)
+            if(currNode->next == NULL)
+              throw std::out_of_range("Can't increment when pointing to end");
 
           ConstIterator curr = *this;
           currNode = currNode->next;
@@ -296,8 +618,9 @@ namespace aisdi
 
         ConstIterator& operator--()
         {
-          if(currNode->prev->prev == NULL)
-            throw std::out_of_range("Cannot decrement when pointing to first elem");
+          if constexpr (IteratorPolicy::checked)
+            if(currNode->prev->prev == NULL)
+              throw std::out_of_range("Cannot decrement when pointing to first elem");
 
           currNode = currNode->prev;
           return *this;
@@ -305,8 +628,9 @@ namespace aisdi
 
         ConstIterator operator--(int)
         {
-          if(currNode->prev->prev == NULL)
-            throw std::out_of_range("Cannot decrement when pointing to first elem");
+          if constexpr (IteratorPolicy::checked)
+            if(currNode->prev->prev == NULL)
+              throw std::out_of_range("Cannot decrement when pointing to first elem");
 
           ConstIterator curr = *this;
           currNode = currNode->prev;
@@ -348,8 +672,9 @@ namespace aisdi
         }
     };
 
-    template <typename Type>
-    class LinkedList<Type>::Iterator : public LinkedList<Type>::ConstIterator
+    template <typename Type, typename Allocator, typename IteratorPolicy>
+    class LinkedList<Type, Allocator, IteratorPolicy>::Iterator
+      : public LinkedList<Type, Allocator, IteratorPolicy>::ConstIterator
     {
     public:
         using pointer = typename LinkedList::pointer;
@@ -405,6 +730,14 @@ namespace aisdi
         }
     };
 
+    namespace pmr
+    {
+
+        template <typename Type, typename IteratorPolicy = DefaultIteratorPolicy>
+        using LinkedList = aisdi::LinkedList<Type, std::pmr::polymorphic_allocator<Type>, IteratorPolicy>;
+
+    }
+
 }
 
 #endif // AISDI_LINEAR_LINKEDLIST_H
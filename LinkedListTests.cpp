@@ -1,8 +1,20 @@
 #include <LinkedList.h>
+#include <Snapshot.h>
 
+#include <algorithm>
 #include <initializer_list>
 #include <complex>
 #include <cstdint>
+#include <cstdio>
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/test_tools.hpp>
@@ -17,6 +29,42 @@ using LinearCollection = aisdi::LinkedList<T>;
 using std::begin;
 using std::end;
 
+namespace
+{
+
+template <typename T>
+struct PropagatingAllocator
+{
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+
+  std::shared_ptr<int> live;
+
+  PropagatingAllocator() : live(std::make_shared<int>(0)) {}
+  template <typename U>
+  PropagatingAllocator(const PropagatingAllocator<U>& other) : live(other.live) {}
+
+  T* allocate(std::size_t n)
+  {
+    ++*live;
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n)
+  {
+    --*live;
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  template <typename U>
+  bool operator==(const PropagatingAllocator<U>& other) const { return live == other.live; }
+  template <typename U>
+  bool operator!=(const PropagatingAllocator<U>& other) const { return live != other.live; }
+};
+
+}
+
 BOOST_AUTO_TEST_SUITE(LinkedListTests)
 
 template <typename T>
@@ -716,6 +764,306 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingRange_ThenSizeI
   BOOST_CHECK_EQUAL(collection.getSize(), 2);
 }
 
+BOOST_AUTO_TEST_CASE(GivenMoveOnlyType_WhenInsertingRvaluesAndEmplacing_ThenItemsAreMovedIn)
+{
+  LinearCollection<std::unique_ptr<int>> collection;
+
+  collection.append(std::unique_ptr<int>(new int(2)));
+  collection.prepend(std::unique_ptr<int>(new int(1)));
+  collection.emplaceBack(new int(4));
+  collection.emplace(collection.begin() + 2, new int(3));
+  collection.emplaceFront(new int(0));
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 5);
+  int expected = 0;
+  for (auto it = collection.begin(); it != collection.end(); ++it)
+    BOOST_CHECK_EQUAL(**it, expected++);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMonotonicResource_WhenFillingPmrCollection_ThenNodesComeFromTheResource)
+{
+  unsigned char buffer[4096];
+  std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+  aisdi::pmr::LinkedList<int> collection(&resource);
+
+  for (int i = 0; i < 100; ++i)
+    collection.append(i);
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 100);
+  BOOST_CHECK(collection.getAllocator().resource() == &resource);
+}
+
+BOOST_AUTO_TEST_CASE(GivenPmrCollections_WhenMoveAssigningAcrossResources_ThenItemsAreTransferred)
+{
+  std::pmr::monotonic_buffer_resource firstResource;
+  std::pmr::monotonic_buffer_resource secondResource;
+  aisdi::pmr::LinkedList<int> collection(&firstResource);
+  aisdi::pmr::LinkedList<int> other({ 1, 2, 3 }, &secondResource);
+
+  collection = std::move(other);
+
+  BOOST_CHECK(collection.getAllocator().resource() == &firstResource);
+  BOOST_CHECK(other.isEmpty());
+  const std::initializer_list<int> expected = { 1, 2, 3 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection),
+                                begin(expected), end(expected));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenSavingAndLoadingSnapshot_ThenItemsRoundTrip,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 3, 1, 4, 1, 5, 9, 2, 6 };
+  LinearCollection<T> loaded = { 42 };
+  std::stringstream stream;
+
+  aisdi::saveTo(collection, stream);
+  aisdi::loadFrom(loaded, stream);
+
+  thenCollectionContainsValues(loaded, { 3, 1, 4, 1, 5, 9, 2, 6 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenStringCollection_WhenSavingToFileDescriptor_ThenItemsRoundTrip)
+{
+  LinearCollection<std::string> collection = { "ala", "", "ma kota i psa, a kot ma ale" };
+  LinearCollection<std::string> loaded;
+  std::FILE* file = std::tmpfile();
+  BOOST_REQUIRE(file != nullptr);
+
+  aisdi::saveTo(collection, fileno(file));
+  std::rewind(file);
+  aisdi::loadFrom(loaded, fileno(file));
+  std::fclose(file);
+
+  const std::initializer_list<std::string> expected = { "ala", "", "ma kota i psa, a kot ma ale" };
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(loaded), end(loaded), begin(expected), end(expected));
+}
+
+BOOST_AUTO_TEST_CASE(GivenCorruptedSnapshot_WhenLoading_ThenOperationThrowsAndCollectionIsEmpty)
+{
+  LinearCollection<int> collection = { 1, 2, 3 };
+  std::stringstream stream;
+  aisdi::saveTo(collection, stream);
+  std::string bytes = stream.str();
+  bytes[bytes.size() - 1] ^= 0x40;
+  std::stringstream corrupted(bytes);
+  std::stringstream truncated(bytes.substr(0, bytes.size() - 2));
+
+  BOOST_CHECK_THROW(aisdi::loadFrom(collection, corrupted), std::runtime_error);
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK_THROW(aisdi::loadFrom(collection, truncated), std::runtime_error);
+  BOOST_CHECK(collection.isEmpty());
+  collection.append(4);
+  std::stringstream foreign(std::string(64, 'x'));
+  BOOST_CHECK_THROW(aisdi::loadFrom(collection, foreign), std::runtime_error);
+  BOOST_CHECK(collection.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenUncheckedIterators_WhenIterating_ThenTheyWalkTheSameItems,
+                              T,
+                              TestedTypes)
+{
+  aisdi::LinkedList<T, std::allocator<T>, aisdi::UncheckedIterators> collection = { 1, 2, 3 };
+
+  auto it = end(collection);
+  --it;
+  collection.erase(begin(collection) + 1);
+
+  const int expected[] = { 1, 3 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection), begin(expected), end(expected));
+  BOOST_CHECK_EQUAL(*it, T(3));
+  BOOST_CHECK_EQUAL(collection.popLast(), T(3));
+}
+
+BOOST_AUTO_TEST_CASE(GivenCheckedIterators_WhenSteppingPastEnds_ThenOperationThrows)
+{
+  aisdi::LinkedList<int, std::allocator<int>, aisdi::CheckedIterators> collection = { 1 };
+
+  BOOST_CHECK_THROW(*end(collection), std::out_of_range);
+  BOOST_CHECK_THROW(++end(collection), std::out_of_range);
+  BOOST_CHECK_THROW(--begin(collection), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenRemovingIf_ThenMatchingItemsAreRemovedInOrder,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3, 4, 5, 6, 7 };
+
+  auto removed = collection.removeIf([](const T& item) { return std::real(item) > 2 && std::real(item) < 6; });
+
+  BOOST_CHECK_EQUAL(removed, 3);
+  thenCollectionContainsValues(collection, { 1, 2, 6, 7 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenRemovingValue_ThenEveryCopyIsRemoved,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 4, 1, 4, 2, 4, 4, 3 };
+
+  BOOST_CHECK_EQUAL(collection.removeValue(4), 4);
+  BOOST_CHECK_EQUAL(collection.removeValue(9), 0);
+  thenCollectionContainsValues(collection, { 1, 2, 3 });
+  BOOST_CHECK_EQUAL(collection.removeIf([](const T&) { return true; }), 3);
+  BOOST_CHECK(collection.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenOwnElement_WhenRemovingValue_ThenEveryCopyIsRemoved)
+{
+  LinearCollection<std::string> collection = { "a", "b", "a", "c", "a" };
+
+  BOOST_CHECK_EQUAL(collection.removeValue(*collection.begin()), 3);
+
+  const std::string expected[] = { "b", "c" };
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection), begin(expected), end(expected));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenSorting_ThenNodesAreRelinkedInOrder,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 5, 3, 9, 1, 7, 2, 8, 6, 4 };
+  const T* five = &*begin(collection);
+
+  collection.sort([](const T& a, const T& b) { return std::real(a) < std::real(b); });
+
+  thenCollectionContainsValues(collection, { 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+  BOOST_CHECK(&*(begin(collection) + 4) == five);
+  BOOST_CHECK_EQUAL(*(--end(collection)), T(9));
+}
+
+BOOST_AUTO_TEST_CASE(GivenThrowingComparator_WhenSorting_ThenEveryItemIsKept)
+{
+  const std::string expected[] = { "a", "b", "c", "d", "e", "f", "g", "h", "i" };
+
+  for(int failingComparison = 1; failingComparison <= 20; failingComparison++)
+  {
+    LinearCollection<std::string> collection = { "f", "c", "h", "a", "i", "e", "b", "g", "d" };
+    int comparisons = 0;
+    auto fragile = [&](const std::string& a, const std::string& b)
+    {
+      if(++comparisons == failingComparison)
+        throw std::runtime_error("comparator failed");
+      return a < b;
+    };
+
+    BOOST_CHECK_THROW(collection.sort(fragile), std::runtime_error);
+
+    BOOST_CHECK_EQUAL(collection.getSize(), 9);
+    std::vector<std::string> forward(collection.begin(), collection.end());
+    std::vector<std::string> backward;
+    for(auto it = collection.end(); it != collection.begin();)
+      backward.push_back(*--it);
+    BOOST_CHECK_EQUAL_COLLECTIONS(forward.rbegin(), forward.rend(), backward.begin(), backward.end());
+    std::sort(forward.begin(), forward.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(forward.begin(), forward.end(), begin(expected), end(expected));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenEqualKeys_WhenSorting_ThenOriginalOrderIsKept)
+{
+  LinearCollection<std::pair<int, int>> collection;
+  std::list<std::pair<int, int>> expected;
+  for(int i = 0; i < 1000; ++i)
+  {
+    collection.append({ (i * 7919) % 13, i });
+    expected.push_back({ (i * 7919) % 13, i });
+  }
+  auto byKey = [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; };
+
+  collection.stableSort(byKey);
+  expected.sort(byKey);
+
+  BOOST_CHECK(std::equal(begin(collection), end(collection), expected.begin(), expected.end()));
+  BOOST_CHECK_EQUAL(collection.getSize(), 1000);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenCheckingMoveOperations_ThenTheyAreNoexcept)
+{
+  BOOST_CHECK(std::is_nothrow_default_constructible<LinearCollection<std::string>>::value);
+  BOOST_CHECK(std::is_nothrow_move_constructible<LinearCollection<std::string>>::value);
+  BOOST_CHECK(std::is_nothrow_move_assignable<LinearCollection<std::string>>::value);
+  BOOST_CHECK(std::is_nothrow_swappable<LinearCollection<std::string>>::value);
+}
+
+BOOST_AUTO_TEST_CASE(GivenTypeWithoutDefaultConstructor_WhenStoring_ThenListWorks)
+{
+  struct NoDefault
+  {
+    explicit NoDefault(int v) : value(v) {}
+    int value;
+  };
+  LinearCollection<NoDefault> collection;
+
+  collection.emplaceBack(2);
+  collection.emplaceFront(1);
+
+  BOOST_CHECK_EQUAL((*begin(collection)).value, 1);
+  BOOST_CHECK_EQUAL((*(--end(collection))).value, 2);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoCollections_WhenSwapping_ThenNodesAreExchanged,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+  LinearCollection<T> other;
+  const T* node = &*begin(collection);
+
+  swap(collection, other);
+
+  BOOST_CHECK(collection.isEmpty());
+  thenCollectionContainsValues(other, { 1, 2, 3 });
+  BOOST_CHECK(&*begin(other) == node);
+  BOOST_CHECK_EQUAL(*(--end(other)), T(3));
+
+  other.swap(collection);
+
+  thenCollectionContainsValues(collection, { 1, 2, 3 });
+  BOOST_CHECK(other.isEmpty());
+  other.append(T(7));
+  thenCollectionContainsValues(other, { 7 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenPmrCollection_WhenCreatingMovingAndSwapping_ThenNothingIsAllocated)
+{
+  std::pmr::monotonic_buffer_resource resource;
+  aisdi::pmr::LinkedList<int> collection({ 1, 2, 3 }, &resource);
+  // The null resource throws on any allocation.
+  aisdi::pmr::LinkedList<int> empty(std::pmr::null_memory_resource());
+  aisdi::pmr::LinkedList<int> other(&resource);
+
+  aisdi::pmr::LinkedList<int> moved(std::move(collection));
+  other = std::move(moved);
+  swap(other, collection);
+
+  BOOST_CHECK(empty.isEmpty());
+  BOOST_CHECK(other.isEmpty());
+  BOOST_CHECK_EQUAL(collection.getSize(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(GivenPropagatingAllocator_WhenAssigning_ThenAllocatorFollowsSource)
+{
+  PropagatingAllocator<int> firstAllocator;
+  PropagatingAllocator<int> secondAllocator;
+  PropagatingAllocator<int> thirdAllocator;
+  aisdi::LinkedList<int, PropagatingAllocator<int>> collection({ 1, 2, 3 }, firstAllocator);
+  aisdi::LinkedList<int, PropagatingAllocator<int>> source({ 4, 5 }, secondAllocator);
+  aisdi::LinkedList<int, PropagatingAllocator<int>> moved({ 6 }, thirdAllocator);
+
+  collection = source;
+
+  BOOST_CHECK_EQUAL(*firstAllocator.live, 0);
+  BOOST_CHECK(collection.getAllocator() == secondAllocator);
+  BOOST_CHECK_EQUAL(collection.getSize(), 2);
+
+  source = std::move(moved);
+
+  BOOST_CHECK(source.getAllocator() == thirdAllocator);
+  BOOST_CHECK_EQUAL(source.getSize(), 1);
+}
+
 // ConstIterator is tested via Iterator methods.
 // If Iterator methods are to be changed, then new ConstIterator tests are required.
 
@@ -0,0 +1,304 @@
+#ifndef AISDI_LINEAR_MAPPEDVECTOR_H
+#define AISDI_LINEAR_MAPPEDVECTOR_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "IndexedIterator.h"
+
+namespace aisdi
+{
+
+// Vector whose elements live in a memory-mapped file. Reopening the file maps the elements
+// written earlier straight back in, with no parse or load step. The file starts with a
+// 64-byte header (magic, element size, element count) followed by the raw elements.
+template <typename Type>
+class MappedVector
+{
+    static_assert(std::is_trivially_copyable<Type>::value,
+                  "MappedVector stores raw bytes and needs a trivially copyable type");
+    static_assert(alignof(Type) <= 64, "MappedVector keeps elements 64-byte aligned at most");
+
+public:
+    using difference_type = std::ptrdiff_t;
+    using size_type = std::size_t;
+    using value_type = Type;
+    using pointer = Type*;
+    using reference = Type&;
+    using const_pointer = const Type*;
+    using const_reference = const Type&;
+
+    using ConstIterator = IndexedConstIterator<MappedVector>;
+    using Iterator = IndexedIterator<MappedVector>;
+    using iterator = Iterator;
+    using const_iterator = ConstIterator;
+
+    static constexpr size_type InitialCapacity = 1024;
+
+private:
+    struct Header
+    {
+        char magic[8];
+        std::uint64_t elementSize;
+        std::uint64_t count;
+        std::uint64_t reserved[5];
+    };
+
+    static_assert(sizeof(Header) == 64, "MappedVector header must stay 64 bytes");
+
+    static constexpr char Magic[8] = {'A', 'I', 'S', 'D', 'I', 'M', 'V', '1'};
+
+    int fd;
+    void* mapping;
+    size_type mappedBytes;
+
+    static void fail(const char* what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    Header* header() const
+    {
+        return static_cast<Header*>(mapping);
+    }
+
+    Type* elements() const
+    {
+        return reinterpret_cast<Type*>(static_cast<char*>(mapping) + sizeof(Header));
+    }
+
+    static size_type bytesFor(size_type capacity)
+    {
+        return sizeof(Header) + capacity * sizeof(Type);
+    }
+
+    void remap(size_type newBytes)
+    {
+        if(ftruncate(fd, newBytes) != 0)
+            fail("Cannot resize mapped vector file");
+#ifdef MREMAP_MAYMOVE
+        void* newMapping = mremap(mapping, mappedBytes, newBytes, MREMAP_MAYMOVE);
+        if(newMapping == MAP_FAILED)
+            fail("Cannot remap mapped vector file");
+#else
+        void* newMapping = mmap(nullptr, newBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if(newMapping == MAP_FAILED)
+            fail("Cannot map mapped vector file");
+        munmap(mapping, mappedBytes);
+#endif
+        mapping = newMapping;
+        mappedBytes = newBytes;
+    }
+
+    void close()
+    {
+        if(mapping != nullptr)
+            munmap(mapping, mappedBytes);
+        if(fd >= 0)
+            ::close(fd);
+        mapping = nullptr;
+        fd = -1;
+        mappedBytes = 0;
+    }
+
+public:
+    // Opens the vector stored at path, creating an empty one if the file is missing or empty.
+    explicit MappedVector(const std::string& path)
+        : fd(-1), mapping(nullptr), mappedBytes(0)
+    {
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if(fd < 0)
+            fail("Cannot open mapped vector file");
+
+        struct stat info;
+        if(fstat(fd, &info) != 0)
+        {
+            int error = errno;
+            close();
+            errno = error;
+            fail("Cannot stat mapped vector file");
+        }
+
+        bool fresh = info.st_size == 0;
+        size_type bytes = fresh ? bytesFor(InitialCapacity) : static_cast<size_type>(info.st_size);
+        if(!fresh && bytes < sizeof(Header))
+        {
+            close();
+            throw std::runtime_error("File is too small to hold a mapped vector");
+        }
+        if(fresh && ftruncate(fd, bytes) != 0)
+        {
+            int error = errno;
+            close();
+            errno = error;
+            fail("Cannot size mapped vector file");
+        }
+
+        mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if(mapping == MAP_FAILED)
+        {
+            int error = errno;
+            mapping = nullptr;
+            close();
+            errno = error;
+            fail("Cannot map mapped vector file");
+        }
+        mappedBytes = bytes;
+
+        if(fresh)
+        {
+            std::memcpy(header()->magic, Magic, sizeof(Magic));
+            header()->elementSize = sizeof(Type);
+            header()->count = 0;
+        }
+        else if(std::memcmp(header()->magic, Magic, sizeof(Magic)) != 0
+                || header()->elementSize != sizeof(Type)
+                || header()->count > capacity())
+        {
+            close();
+            throw std::runtime_error("File does not hold a mapped vector of this element type");
+        }
+    }
+
+    MappedVector(const MappedVector&) = delete;
+    MappedVector& operator=(const MappedVector&) = delete;
+
+    MappedVector(MappedVector&& other) noexcept
+        : fd(other.fd), mapping(other.mapping), mappedBytes(other.mappedBytes)
+    {
+        other.fd = -1;
+        other.mapping = nullptr;
+        other.mappedBytes = 0;
+    }
+
+    MappedVector& operator=(MappedVector&& other) noexcept
+    {
+        if(this != &other)
+        {
+            close();
+            std::swap(fd, other.fd);
+            std::swap(mapping, other.mapping);
+            std::swap(mappedBytes, other.mappedBytes);
+        }
+        return *this;
+    }
+
+    ~MappedVector()
+    {
+        close();
+    }
+
+    bool isEmpty() const
+    {
+        return getSize() == 0;
+    }
+
+    size_type getSize() const
+    {
+        return mapping == nullptr ? 0 : header()->count;
+    }
+
+    size_type capacity() const
+    {
+        return mapping == nullptr ? 0 : (mappedBytes - sizeof(Header)) / sizeof(Type);
+    }
+
+    void reserve(size_type n)
+    {
+        if(n > capacity())
+            remap(bytesFor(n));
+    }
+
+    void append(const Type& item)
+    {
+        if(getSize() == capacity())
+        {
+            // item may point into the mapping that is about to move
+            Type copy = item;
+            reserve(capacity() > 0 ? capacity() * 2 : InitialCapacity);
+            elements()[header()->count++] = copy;
+            return;
+        }
+        elements()[header()->count++] = item;
+    }
+
+    Type popLast()
+    {
+        if(isEmpty())
+            throw std::logic_error("Cannot pop last element when collection is empty");
+        return elements()[--header()->count];
+    }
+
+    // Writes dirty pages back to the file; the kernel does so eventually on its own as well.
+    void flush()
+    {
+        if(mapping != nullptr && msync(mapping, mappedBytes, MS_SYNC) != 0)
+            fail("Cannot flush mapped vector file");
+    }
+
+    Type* data()
+    {
+        return elements();
+    }
+
+    const Type* data() const
+    {
+        return elements();
+    }
+
+    reference operator[](size_type index)
+    {
+        return elements()[index];
+    }
+
+    const_reference operator[](size_type index) const
+    {
+        return elements()[index];
+    }
+
+    iterator begin()
+    {
+        return iterator(cbegin());
+    }
+
+    iterator end()
+    {
+        return iterator(cend());
+    }
+
+    const_iterator cbegin() const
+    {
+        return ConstIterator(0, this);
+    }
+
+    const_iterator cend() const
+    {
+        return ConstIterator(getSize(), this);
+    }
+
+    const_iterator begin() const
+    {
+        return cbegin();
+    }
+
+    const_iterator end() const
+    {
+        return cend();
+    }
+};
+
+}
+
+#endif // AISDI_LINEAR_MAPPEDVECTOR_H
@@ -0,0 +1,102 @@
+#include <MappedVector.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+#include <unistd.h>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+template <typename T>
+using LinearCollection = aisdi::MappedVector<T>;
+
+BOOST_AUTO_TEST_SUITE(MappedVectorTests)
+
+namespace
+{
+
+struct TemporaryFile
+{
+  std::string path;
+
+  TemporaryFile()
+    : path((std::filesystem::temp_directory_path()
+            / ("aisdi-mapped-" + std::to_string(::getpid()) + "-" + std::to_string(counter()++))).string())
+  {}
+
+  ~TemporaryFile()
+  {
+    std::filesystem::remove(path);
+  }
+
+  static int& counter()
+  {
+    static int value = 0;
+    return value;
+  }
+};
+
+struct Record
+{
+  std::uint64_t id;
+  double weight;
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(GivenNewFile_WhenOpened_ThenCollectionIsEmpty)
+{
+  TemporaryFile file;
+  LinearCollection<std::uint64_t> collection(file.path);
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(collection.begin() == collection.end());
+}
+
+BOOST_AUTO_TEST_CASE(GivenWrittenFile_WhenReopened_ThenItemsAreStillThere)
+{
+  TemporaryFile file;
+  {
+    LinearCollection<std::uint64_t> collection(file.path);
+    for (std::uint64_t i = 0; i < 5000; ++i)
+      collection.append(i * 3);
+  }
+
+  LinearCollection<std::uint64_t> reopened(file.path);
+
+  BOOST_CHECK_EQUAL(reopened.getSize(), 5000);
+  BOOST_CHECK_GE(reopened.capacity(), 5000);
+  BOOST_CHECK_EQUAL(*reopened.begin(), 0);
+  BOOST_CHECK_EQUAL(*(reopened.end() - 1), 4999 * 3);
+  BOOST_CHECK_EQUAL(reopened.popLast(), 4999 * 3);
+}
+
+BOOST_AUTO_TEST_CASE(GivenPodRecords_WhenIterating_ThenFieldsAreKept)
+{
+  TemporaryFile file;
+  LinearCollection<Record> collection(file.path);
+
+  collection.append(Record{7, 0.5});
+  collection.append(Record{8, 1.5});
+
+  auto it = collection.begin();
+  BOOST_CHECK_EQUAL(it->id, 7);
+  BOOST_CHECK_EQUAL((++it)->weight, 1.5);
+  BOOST_CHECK_THROW(*(++it), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenFileOfOtherElementType_WhenOpened_ThenOperationThrows)
+{
+  TemporaryFile file;
+  {
+    LinearCollection<std::uint32_t> collection(file.path);
+    collection.append(1);
+  }
+
+  BOOST_CHECK_THROW(LinearCollection<std::uint64_t>{file.path}, std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
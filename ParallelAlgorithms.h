@@ -0,0 +1,417 @@
+#ifndef AISDI_LINEAR_PARALLELALGORITHMS_H
+#define AISDI_LINEAR_PARALLELALGORITHMS_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aisdi
+{
+
+// Work-stealing pool: every worker owns a deque, pops its own work from the back and steals
+// from the front of the others when it runs dry. Threads waiting in run() help out instead
+// of blocking, so nested parallel calls cannot deadlock.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(std::size_t threadCount = std::thread::hardware_concurrency())
+    {
+        if(threadCount == 0)
+            threadCount = 1;
+        for(std::size_t i = 0; i < threadCount; ++i)
+            queues.emplace_back(new Queue);
+        for(std::size_t i = 0; i < threadCount; ++i)
+            workers.emplace_back([this, i] { workerLoop(i); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+        for(auto& worker : workers)
+            worker.join();
+    }
+
+    static ThreadPool& shared()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    std::size_t getSize() const
+    {
+        return workers.size();
+    }
+
+    // Calls task(i) for every i in [0, count) and returns once all calls are done.
+    // The first exception thrown by a task is rethrown here.
+    template <typename Task>
+    void run(std::size_t count, const Task& task)
+    {
+        std::atomic<std::size_t> remaining(count);
+        std::exception_ptr failure;
+        std::mutex failureMutex;
+
+        for(std::size_t i = 0; i < count; ++i)
+            push([&, i]
+            {
+                try
+                {
+                    task(i);
+                }
+                catch(...)
+                {
+                    std::lock_guard<std::mutex> lock(failureMutex);
+                    if(!failure)
+                        failure = std::current_exception();
+                }
+                remaining.fetch_sub(1, std::memory_order_acq_rel);
+            });
+
+        while(remaining.load(std::memory_order_acquire) != 0)
+            if(!tryRunOne())
+                std::this_thread::yield();
+
+        if(failure)
+            std::rethrow_exception(failure);
+    }
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    std::atomic<std::size_t> queued{0};
+    std::atomic<std::size_t> nextQueue{0};
+    bool stopping = false;
+
+    struct WorkerIdentity
+    {
+        const ThreadPool* pool;
+        std::size_t index;
+    };
+
+    static WorkerIdentity& identity()
+    {
+        static thread_local WorkerIdentity current{nullptr, 0};
+        return current;
+    }
+
+    // Index of the calling worker's own queue, or of a round-robin victim for other threads.
+    std::size_t homeQueue()
+    {
+        if(identity().pool == this)
+            return identity().index;
+        return nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    }
+
+    void push(std::function<void()> task)
+    {
+        Queue& queue = *queues[homeQueue()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        queued.fetch_add(1, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        wakeUp.notify_one();
+    }
+
+    bool tryRunOne()
+    {
+        std::size_t home = homeQueue();
+        std::function<void()> task;
+        for(std::size_t i = 0; i < queues.size() && !task; ++i)
+        {
+            Queue& queue = *queues[(home + i) % queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if(queue.tasks.empty())
+                continue;
+            if(i == 0)
+            {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+        }
+        if(!task)
+            return false;
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        task();
+        return true;
+    }
+
+    void workerLoop(std::size_t index)
+    {
+        identity() = WorkerIdentity{this, index};
+        for(;;)
+        {
+            if(tryRunOne())
+                continue;
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wakeUp.wait(lock, [this] { return stopping || queued.load(std::memory_order_acquire) != 0; });
+            if(stopping && queued.load(std::memory_order_acquire) == 0)
+                return;
+        }
+    }
+};
+
+namespace parallel
+{
+
+// Inputs below this many elements per chunk are not worth a task.
+constexpr std::size_t MinChunkLength = 4096;
+constexpr std::size_t CacheLineSize = 64;
+
+struct ChunkPlan
+{
+    std::size_t chunkLength;
+    std::size_t chunkCount;
+};
+
+// Splits n elements into contiguous chunks, a few per worker, each a multiple of a cache
+// line's worth of elements.
+inline ChunkPlan planChunks(std::size_t n, std::size_t elementSize, const ThreadPool& pool)
+{
+    if(n == 0)
+        return ChunkPlan{0, 0};
+    std::size_t lineElements = std::max<std::size_t>(1, CacheLineSize / elementSize);
+    std::size_t chunkCount = std::min(pool.getSize() * 4, (n + MinChunkLength - 1) / MinChunkLength);
+    chunkCount = std::max<std::size_t>(1, chunkCount);
+    std::size_t chunkLength = (n + chunkCount - 1) / chunkCount;
+    chunkLength = (chunkLength + lineElements - 1) / lineElements * lineElements;
+    return ChunkPlan{chunkLength, (n + chunkLength - 1) / chunkLength};
+}
+
+template <typename Value>
+struct alignas(CacheLineSize) PaddedSlot
+{
+    Value value;
+};
+
+// Number of elements of the stable merge of a and b (lengths na, nb) that come from a among
+// the first d merged elements: the smallest i with b[d - i - 1] < a[i].
+template <typename Value, typename Compare>
+std::size_t coRank(std::size_t d, const Value* a, std::size_t na, const Value* b, std::size_t nb,
+                   Compare& compare)
+{
+    std::size_t lo = d > nb ? d - nb : 0;
+    std::size_t hi = std::min(d, na);
+    while(lo < hi)
+    {
+        std::size_t i = lo + (hi - lo) / 2;
+        if(!compare(b[d - i - 1], a[i]))
+            lo = i + 1;
+        else
+            hi = i;
+    }
+    return lo;
+}
+
+// Raw storage for n elements, constructed and destroyed chunk by chunk on the pool.
+template <typename Value>
+class MergeBuffer
+{
+    Value* buffer;
+
+public:
+    explicit MergeBuffer(std::size_t n)
+        : buffer(static_cast<Value*>(::operator new(n * sizeof(Value), std::align_val_t(alignof(Value)))))
+    {}
+
+    MergeBuffer(const MergeBuffer&) = delete;
+    MergeBuffer& operator=(const MergeBuffer&) = delete;
+
+    ~MergeBuffer()
+    {
+        ::operator delete(buffer, std::align_val_t(alignof(Value)));
+    }
+
+    Value* data()
+    {
+        return buffer;
+    }
+};
+
+}
+
+// The algorithms below accept aisdi::Vector and any other container exposing contiguous
+// data() and getSize().
+
+template <typename Container, typename Function>
+void parallelForEach(Container& container, Function function, ThreadPool& pool = ThreadPool::shared())
+{
+    auto* first = container.data();
+    std::size_t n = container.getSize();
+    parallel::ChunkPlan plan = parallel::planChunks(n, sizeof(*first), pool);
+    pool.run(plan.chunkCount, [&](std::size_t chunk)
+    {
+        std::size_t begin = chunk * plan.chunkLength;
+        std::size_t end = std::min(n, begin + plan.chunkLength);
+        for(std::size_t i = begin; i < end; ++i)
+            function(first[i]);
+    });
+}
+
+// Resizes output to match input and fills it with function(element).
+template <typename Input, typename Output, typename Function>
+void parallelTransform(const Input& input, Output& output, Function function,
+                       ThreadPool& pool = ThreadPool::shared())
+{
+    std::size_t n = input.getSize();
+    output.resize(n);
+    const auto* source = input.data();
+    auto* destination = output.data();
+    parallel::ChunkPlan plan = parallel::planChunks(n, sizeof(*destination), pool);
+    pool.run(plan.chunkCount, [&](std::size_t chunk)
+    {
+        std::size_t begin = chunk * plan.chunkLength;
+        std::size_t end = std::min(n, begin + plan.chunkLength);
+        for(std::size_t i = begin; i < end; ++i)
+            destination[i] = function(source[i]);
+    });
+}
+
+// operation must be associative; partial results are combined in chunk order.
+template <typename Container, typename Value, typename Operation>
+Value parallelReduce(const Container& container, Value init, Operation operation,
+                     ThreadPool& pool = ThreadPool::shared())
+{
+    const auto* first = container.data();
+    std::size_t n = container.getSize();
+    parallel::ChunkPlan plan = parallel::planChunks(n, sizeof(*first), pool);
+    std::vector<parallel::PaddedSlot<Value>> partials(plan.chunkCount);
+    pool.run(plan.chunkCount, [&](std::size_t chunk)
+    {
+        std::size_t begin = chunk * plan.chunkLength;
+        std::size_t end = std::min(n, begin + plan.chunkLength);
+        Value partial = first[begin];
+        for(std::size_t i = begin + 1; i < end; ++i)
+            partial = operation(std::move(partial), first[i]);
+        partials[chunk].value = std::move(partial);
+    });
+    for(auto& slot : partials)
+        init = operation(std::move(init), std::move(slot.value));
+    return init;
+}
+
+// Sorts chunks concurrently, then merges neighbouring runs level by level. Every merge is
+// split at co-ranks into pieces of about one chunk, so each level keeps all workers busy up
+// to the last one. Runs alternate between the container and a scratch buffer of n elements.
+template <typename Container, typename Compare = std::less<>>
+void parallelSort(Container& container, Compare compare = Compare(), ThreadPool& pool = ThreadPool::shared())
+{
+    using Value = std::remove_reference_t<decltype(*container.data())>;
+    Value* first = container.data();
+    std::size_t n = container.getSize();
+    parallel::ChunkPlan plan = parallel::planChunks(n, sizeof(Value), pool);
+    pool.run(plan.chunkCount, [&](std::size_t chunk)
+    {
+        std::size_t begin = chunk * plan.chunkLength;
+        std::size_t end = std::min(n, begin + plan.chunkLength);
+        std::sort(first + begin, first + end, compare);
+    });
+    if(plan.chunkCount < 2)
+        return;
+
+    parallel::MergeBuffer<Value> scratch(n);
+    Value* buffer = scratch.data();
+    pool.run(plan.chunkCount, [&](std::size_t chunk)
+    {
+        std::size_t begin = chunk * plan.chunkLength;
+        std::size_t end = std::min(n, begin + plan.chunkLength);
+        std::uninitialized_move(first + begin, first + end, buffer + begin);
+    });
+
+    Value* from = buffer;
+    Value* to = first;
+    try
+    {
+        for(std::size_t run = plan.chunkLength; run < n; run *= 2)
+        {
+            std::size_t piecesPerMerge = 2 * run / plan.chunkLength;
+            std::size_t pieces = (n + 2 * run - 1) / (2 * run) * piecesPerMerge;
+            // Piece task of a merge covers output [outBegin, outEnd) of that merge; empty past n.
+            auto bounds = [&](std::size_t task, std::size_t& begin, std::size_t& middle, std::size_t& end,
+                              std::size_t& outBegin, std::size_t& outEnd)
+            {
+                begin = task / piecesPerMerge * 2 * run;
+                middle = std::min(n, begin + run);
+                end = std::min(n, begin + 2 * run);
+                outBegin = std::min(end, begin + task % piecesPerMerge * plan.chunkLength);
+                outEnd = std::min(end, outBegin + plan.chunkLength);
+            };
+            // All split points are found before any piece moves elements out of the runs.
+            std::vector<std::size_t> splits(pieces);
+            pool.run(pieces, [&](std::size_t task)
+            {
+                std::size_t begin, middle, end, outBegin, outEnd;
+                bounds(task, begin, middle, end, outBegin, outEnd);
+                splits[task] = parallel::coRank(outBegin - begin, from + begin, middle - begin,
+                                                from + middle, end - middle, compare);
+            });
+            pool.run(pieces, [&](std::size_t task)
+            {
+                std::size_t begin, middle, end, outBegin, outEnd;
+                bounds(task, begin, middle, end, outBegin, outEnd);
+                if(outBegin == outEnd)
+                    return;
+                std::size_t i0 = splits[task];
+                std::size_t i1 = outEnd == end ? middle - begin : splits[task + 1];
+                std::size_t j0 = outBegin - begin - i0;
+                std::size_t j1 = outEnd - begin - i1;
+                std::merge(std::make_move_iterator(from + begin + i0), std::make_move_iterator(from + begin + i1),
+                           std::make_move_iterator(from + middle + j0), std::make_move_iterator(from + middle + j1),
+                           to + outBegin, compare);
+            });
+            std::swap(from, to);
+        }
+    }
+    catch(...)
+    {
+        std::destroy(buffer, buffer + n);
+        throw;
+    }
+
+    pool.run(plan.chunkCount, [&](std::size_t chunk)
+    {
+        std::size_t begin = chunk * plan.chunkLength;
+        std::size_t end = std::min(n, begin + plan.chunkLength);
+        if(from != first)
+            std::move(buffer + begin, buffer + end, first + begin);
+        std::destroy(buffer + begin, buffer + end);
+    });
+}
+}
+
+#endif // AISDI_LINEAR_PARALLELALGORITHMS_H
@@ -0,0 +1,126 @@
+#include <ParallelAlgorithms.h>
+#include <Vector.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+template <typename T>
+using LinearCollection = aisdi::Vector<T>;
+
+BOOST_AUTO_TEST_SUITE(ParallelAlgorithmsTests)
+
+namespace
+{
+
+LinearCollection<std::int64_t> makeDescending(std::int64_t n)
+{
+  LinearCollection<std::int64_t> collection;
+  collection.reserve(n);
+  for (std::int64_t i = n; i > 0; --i)
+    collection.append(i);
+  return collection;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(GivenLargeCollection_WhenRunningForEach_ThenEveryItemIsVisitedOnce)
+{
+  aisdi::ThreadPool pool(4);
+  auto collection = makeDescending(100000);
+
+  aisdi::parallelForEach(collection, [](std::int64_t& item) { item *= 2; }, pool);
+
+  BOOST_CHECK_EQUAL(*collection.begin(), 200000);
+  BOOST_CHECK_EQUAL(*(collection.end() - 1), 2);
+}
+
+BOOST_AUTO_TEST_CASE(GivenLargeCollection_WhenTransforming_ThenOutputHoldsResults)
+{
+  aisdi::ThreadPool pool(4);
+  auto collection = makeDescending(50000);
+  LinearCollection<double> output;
+
+  aisdi::parallelTransform(collection, output, [](std::int64_t item) { return item / 2.0; }, pool);
+
+  BOOST_CHECK_EQUAL(output.getSize(), 50000);
+  BOOST_CHECK_EQUAL(*output.begin(), 25000.0);
+  BOOST_CHECK_EQUAL(*(output.end() - 1), 0.5);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenReducing_ThenResultMatchesSequentialSum)
+{
+  aisdi::ThreadPool pool(4);
+  auto collection = makeDescending(100000);
+  LinearCollection<std::int64_t> empty;
+
+  BOOST_CHECK_EQUAL(aisdi::parallelReduce(collection, std::int64_t(7), std::plus<>(), pool),
+                    std::int64_t(100000) * 100001 / 2 + 7);
+  BOOST_CHECK_EQUAL(aisdi::parallelReduce(empty, std::int64_t(7), std::plus<>(), pool), 7);
+}
+
+BOOST_AUTO_TEST_CASE(GivenUnsortedCollection_WhenSorting_ThenItIsSorted)
+{
+  aisdi::ThreadPool pool(4);
+  auto collection = makeDescending(123457);
+
+  aisdi::parallelSort(collection, std::less<>(), pool);
+
+  std::int64_t expected = 1;
+  bool sorted = true;
+  for (auto it = collection.begin(); it != collection.end(); ++it)
+    sorted = sorted && *it == expected++;
+  BOOST_CHECK(sorted);
+}
+
+BOOST_AUTO_TEST_CASE(GivenStringsInUnevenChunks_WhenSorting_ThenResultMatchesStdSort)
+{
+  aisdi::ThreadPool pool(2);
+  LinearCollection<std::string> collection;
+  std::vector<std::string> expected;
+  for (std::uint32_t i = 0; i < 5 * 4096 + 17; ++i)
+  {
+    std::string item = std::to_string(i * 2654435761u % 10007);
+    collection.append(item);
+    expected.push_back(item);
+  }
+
+  aisdi::parallelSort(collection, std::less<>(), pool);
+  std::sort(expected.begin(), expected.end());
+
+  BOOST_CHECK(std::equal(collection.begin(), collection.end(), expected.begin(), expected.end()));
+}
+
+BOOST_AUTO_TEST_CASE(GivenThrowingFunction_WhenRunningForEach_ThenExceptionReachesCaller)
+{
+  aisdi::ThreadPool pool(2);
+  auto collection = makeDescending(20000);
+
+  BOOST_CHECK_THROW(aisdi::parallelForEach(collection, [](std::int64_t& item)
+                    {
+                      if (item == 5)
+                        throw std::runtime_error("bad item");
+                    }, pool),
+                    std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenNestedParallelCalls_WhenRunning_ThenTheyComplete)
+{
+  aisdi::ThreadPool pool(2);
+  std::atomic<int> calls(0);
+
+  pool.run(8, [&](std::size_t)
+  {
+    pool.run(8, [&](std::size_t) { ++calls; });
+  });
+
+  BOOST_CHECK_EQUAL(calls.load(), 64);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
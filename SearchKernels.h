@@ -0,0 +1,240 @@
+#ifndef AISDI_LINEAR_SEARCHKERNELS_H
+#define AISDI_LINEAR_SEARCHKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define AISDI_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace aisdi
+{
+
+namespace simd
+{
+
+template <typename Type>
+std::size_t findFirstScalar(const Type* data, std::size_t n, const Type& value)
+{
+    for(std::size_t i = 0; i < n; ++i)
+        if(data[i] == value)
+            return i;
+    return n;
+}
+
+template <typename Type>
+std::size_t countScalar(const Type* data, std::size_t n, const Type& value)
+{
+    std::size_t result = 0;
+    for(std::size_t i = 0; i < n; ++i)
+        if(data[i] == value)
+            ++result;
+    return result;
+}
+
+// Arithmetic types whose lanes fit the integer/float compare instructions.
+template <typename Type>
+struct HasSimdKernel
+    : std::integral_constant<bool, std::is_arithmetic<Type>::value
+                                   && (sizeof(Type) == 1 || sizeof(Type) == 2
+                                       || sizeof(Type) == 4 || sizeof(Type) == 8)>
+{};
+
+#ifdef AISDI_X86_SIMD
+
+// Every kernel turns a block comparison into a byte mask via movemask_epi8, so a matching
+// lane shows up as sizeof(Type) set bits whatever the lane width.
+
+template <typename Type>
+__attribute__((target("sse2"))) inline __m128i broadcastSse2(const Type& value)
+{
+    if constexpr (sizeof(Type) == 1)
+    {
+        std::int8_t bits;
+        std::memcpy(&bits, &value, 1);
+        return _mm_set1_epi8(bits);
+    }
+    else if constexpr (sizeof(Type) == 2)
+    {
+        std::int16_t bits;
+        std::memcpy(&bits, &value, 2);
+        return _mm_set1_epi16(bits);
+    }
+    else if constexpr (sizeof(Type) == 4)
+    {
+        std::int32_t bits;
+        std::memcpy(&bits, &value, 4);
+        return _mm_set1_epi32(bits);
+    }
+    else
+    {
+        std::int64_t bits;
+        std::memcpy(&bits, &value, 8);
+        return _mm_set1_epi64x(bits);
+    }
+}
+
+template <typename Type>
+__attribute__((target("sse2"))) inline __m128i equalSse2(__m128i block, __m128i needle)
+{
+    if constexpr (std::is_same<Type, float>::value)
+        return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(block), _mm_castsi128_ps(needle)));
+    else if constexpr (std::is_same<Type, double>::value)
+        return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(block), _mm_castsi128_pd(needle)));
+    else if constexpr (sizeof(Type) == 1)
+        return _mm_cmpeq_epi8(block, needle);
+    else if constexpr (sizeof(Type) == 2)
+        return _mm_cmpeq_epi16(block, needle);
+    else if constexpr (sizeof(Type) == 4)
+        return _mm_cmpeq_epi32(block, needle);
+    else
+    {
+        // SSE2 has no 64-bit compare: both 32-bit halves have to match.
+        __m128i halves = _mm_cmpeq_epi32(block, needle);
+        return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+}
+
+template <typename Type>
+__attribute__((target("avx2"))) inline __m256i equalAvx2(__m256i block, __m256i needle)
+{
+    if constexpr (std::is_same<Type, float>::value)
+        return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(block),
+                                                 _mm256_castsi256_ps(needle), _CMP_EQ_OQ));
+    else if constexpr (std::is_same<Type, double>::value)
+        return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(block),
+                                                 _mm256_castsi256_pd(needle), _CMP_EQ_OQ));
+    else if constexpr (sizeof(Type) == 1)
+        return _mm256_cmpeq_epi8(block, needle);
+    else if constexpr (sizeof(Type) == 2)
+        return _mm256_cmpeq_epi16(block, needle);
+    else if constexpr (sizeof(Type) == 4)
+        return _mm256_cmpeq_epi32(block, needle);
+    else
+        return _mm256_cmpeq_epi64(block, needle);
+}
+
+template <typename Type>
+__attribute__((target("sse2"))) std::size_t findFirstSse2(const Type* data, std::size_t n, const Type& value)
+{
+    constexpr std::size_t lanes = 16 / sizeof(Type);
+    const __m128i needle = broadcastSse2(value);
+    std::size_t i = 0;
+    for(; i + lanes <= n; i += lanes)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        unsigned mask = _mm_movemask_epi8(equalSse2<Type>(block, needle));
+        if(mask != 0)
+            return i + __builtin_ctz(mask) / sizeof(Type);
+    }
+    return i + findFirstScalar(data + i, n - i, value);
+}
+
+template <typename Type>
+__attribute__((target("sse2"))) std::size_t countSse2(const Type* data, std::size_t n, const Type& value)
+{
+    constexpr std::size_t lanes = 16 / sizeof(Type);
+    const __m128i needle = broadcastSse2(value);
+    std::size_t matchingBytes = 0;
+    std::size_t i = 0;
+    for(; i + lanes <= n; i += lanes)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        matchingBytes += __builtin_popcount(_mm_movemask_epi8(equalSse2<Type>(block, needle)));
+    }
+    return matchingBytes / sizeof(Type) + countScalar(data + i, n - i, value);
+}
+
+template <typename Type>
+__attribute__((target("avx2"))) std::size_t findFirstAvx2(const Type* data, std::size_t n, const Type& value)
+{
+    constexpr std::size_t lanes = 32 / sizeof(Type);
+    const __m256i needle = _mm256_broadcastsi128_si256(broadcastSse2(value));
+    std::size_t i = 0;
+    for(; i + lanes <= n; i += lanes)
+    {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        unsigned mask = _mm256_movemask_epi8(equalAvx2<Type>(block, needle));
+        if(mask != 0)
+            return i + __builtin_ctz(mask) / sizeof(Type);
+    }
+    return i + findFirstScalar(data + i, n - i, value);
+}
+
+template <typename Type>
+__attribute__((target("avx2"))) std::size_t countAvx2(const Type* data, std::size_t n, const Type& value)
+{
+    constexpr std::size_t lanes = 32 / sizeof(Type);
+    const __m256i needle = _mm256_broadcastsi128_si256(broadcastSse2(value));
+    std::size_t matchingBytes = 0;
+    std::size_t i = 0;
+    for(; i + lanes <= n; i += lanes)
+    {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        matchingBytes += __builtin_popcount(_mm256_movemask_epi8(equalAvx2<Type>(block, needle)));
+    }
+    return matchingBytes / sizeof(Type) + countScalar(data + i, n - i, value);
+}
+
+inline bool hasAvx2()
+{
+    static const bool supported = []
+    {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+    return supported;
+}
+
+inline bool hasSse2()
+{
+    static const bool supported = []
+    {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse2") != 0;
+    }();
+    return supported;
+}
+
+#endif // AISDI_X86_SIMD
+
+// Index of the first element equal to value, or n when there is none.
+template <typename Type>
+std::size_t findFirst(const Type* data, std::size_t n, const Type& value)
+{
+#ifdef AISDI_X86_SIMD
+    if constexpr (HasSimdKernel<Type>::value)
+    {
+        if(hasAvx2())
+            return findFirstAvx2(data, n, value);
+        if(hasSse2())
+            return findFirstSse2(data, n, value);
+    }
+#endif
+    return findFirstScalar(data, n, value);
+}
+
+template <typename Type>
+std::size_t count(const Type* data, std::size_t n, const Type& value)
+{
+#ifdef AISDI_X86_SIMD
+    if constexpr (HasSimdKernel<Type>::value)
+    {
+        if(hasAvx2())
+            return countAvx2(data, n, value);
+        if(hasSse2())
+            return countSse2(data, n, value);
+    }
+#endif
+    return countScalar(data, n, value);
+}
+
+}
+
+}
+
+#endif // AISDI_LINEAR_SEARCHKERNELS_H
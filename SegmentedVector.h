@@ -0,0 +1,438 @@
+#ifndef AISDI_LINEAR_SEGMENTEDVECTOR_H
+#define AISDI_LINEAR_SEGMENTEDVECTOR_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "IndexedIterator.h"
+#include "SearchKernels.h"
+
+namespace aisdi
+{
+
+// Vector built from blocks of FirstBlockLength, 2*FirstBlockLength, 4*FirstBlockLength...
+// elements. Growing adds a block and never moves the elements already stored, so pointers
+// and references to them stay valid until they are erased. Element i lives in block
+// log2(i + FirstBlockLength) - log2(FirstBlockLength); the block directory has a fixed
+// slot per possible block, so it never reallocates either.
+// Inserting or erasing anywhere but the back still shifts the following elements.
+template <typename Type, std::size_t FirstBlockLength = 32, typename Allocator = std::allocator<Type>>
+class SegmentedVector : private Allocator
+{
+    static_assert(FirstBlockLength > 0 && (FirstBlockLength & (FirstBlockLength - 1)) == 0,
+                  "SegmentedVector needs a power-of-two first block length");
+
+public:
+    using difference_type = std::ptrdiff_t;
+    using size_type = std::size_t;
+    using value_type = Type;
+    using pointer = Type*;
+    using reference = Type&;
+    using const_pointer = const Type*;
+    using const_reference = const Type&;
+    using allocator_type = Allocator;
+
+    using ConstIterator = IndexedConstIterator<SegmentedVector>;
+    using Iterator = IndexedIterator<SegmentedVector>;
+    using iterator = Iterator;
+    using const_iterator = ConstIterator;
+
+private:
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    static constexpr unsigned log2(size_type n)
+    {
+        return std::numeric_limits<size_type>::digits - 1 - __builtin_clzll(n);
+    }
+
+    static constexpr unsigned FirstShift = log2(FirstBlockLength);
+    // One block short of the full width, so that capacity and every shifted index still fit
+    // in a size_type.
+    static constexpr unsigned MaxBlocks = std::numeric_limits<size_type>::digits - FirstShift - 1;
+    static constexpr size_type MaxCapacity = (FirstBlockLength << MaxBlocks) - FirstBlockLength;
+
+    Type* blocks[MaxBlocks];
+    unsigned blockCount;
+    size_type elementCount;
+
+    Allocator& alloc()
+    {
+        return *this;
+    }
+
+    const Allocator& alloc() const
+    {
+        return *this;
+    }
+
+    static size_type blockLength(unsigned block)
+    {
+        return FirstBlockLength << block;
+    }
+
+    Type* slot(size_type index) const
+    {
+        size_type shifted = index + FirstBlockLength;
+        unsigned block = log2(shifted) - FirstShift;
+        return blocks[block] + (shifted - blockLength(block));
+    }
+
+    void addBlock()
+    {
+        if(blockCount == MaxBlocks)
+            throw std::length_error("SegmentedVector cannot grow any further");
+        blocks[blockCount] = AllocTraits::allocate(alloc(), blockLength(blockCount));
+        blockCount++;
+    }
+
+    void releaseBlocks()
+    {
+        while(blockCount > 0)
+        {
+            blockCount--;
+            AllocTraits::deallocate(alloc(), blocks[blockCount], blockLength(blockCount));
+        }
+    }
+
+    void destroyFrom(size_type index)
+    {
+        while(elementCount > index)
+        {
+            elementCount--;
+            AllocTraits::destroy(alloc(), slot(elementCount));
+        }
+    }
+
+    // Moves the last element down to index, shifting [index, size-1) one place back.
+    void rotateLastTo(size_type index)
+    {
+        for(size_type i = elementCount - 1; i > index; i--)
+            std::swap(*slot(i), *slot(i - 1));
+    }
+
+    void removeAt(size_type index, size_type n)
+    {
+        for(size_type i = index; i + n < elementCount; i++)
+            *slot(i) = std::move(*slot(i + n));
+        destroyFrom(elementCount - n);
+    }
+
+    size_type checkedIndex(const const_iterator& position, bool allowEnd) const
+    {
+        size_type index = position.index();
+        if(index > elementCount || (!allowEnd && index == elementCount))
+            throw std::out_of_range("Iterator does not point into the collection");
+        return index;
+    }
+
+    template <typename Visit>
+    void forEachBlock(Visit visit) const
+    {
+        size_type remaining = elementCount;
+        for(unsigned block = 0; remaining > 0; block++)
+        {
+            size_type n = remaining < blockLength(block) ? remaining : blockLength(block);
+            if(!visit(blocks[block], n))
+                return;
+            remaining -= n;
+        }
+    }
+
+public:
+    SegmentedVector() : SegmentedVector(Allocator())
+    {}
+
+    explicit SegmentedVector(const Allocator& allocator)
+        : Allocator(allocator), blockCount(0), elementCount(0)
+    {}
+
+    SegmentedVector(std::initializer_list<Type> l, const Allocator& allocator = Allocator())
+        : SegmentedVector(allocator)
+    {
+        reserve(l.size());
+        for(const Type& item : l)
+            append(item);
+    }
+
+    SegmentedVector(const SegmentedVector& other)
+        : SegmentedVector(AllocTraits::select_on_container_copy_construction(other.alloc()))
+    {
+        reserve(other.elementCount);
+        for(size_type i = 0; i < other.elementCount; i++)
+            append(other[i]);
+    }
+
+    SegmentedVector(SegmentedVector&& other)
+        : Allocator(other.alloc()), blockCount(other.blockCount), elementCount(other.elementCount)
+    {
+        for(unsigned block = 0; block < blockCount; block++)
+            blocks[block] = other.blocks[block];
+        other.blockCount = 0;
+        other.elementCount = 0;
+    }
+
+    ~SegmentedVector()
+    {
+        destroyFrom(0);
+        releaseBlocks();
+    }
+
+    SegmentedVector& operator=(const SegmentedVector& other)
+    {
+        if(this == &other)
+            return *this;
+        destroyFrom(0);
+        if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+        {
+            if(alloc() != other.alloc())
+            {
+                releaseBlocks();
+                alloc() = other.alloc();
+            }
+        }
+        reserve(other.elementCount);
+        for(size_type i = 0; i < other.elementCount; i++)
+            append(other[i]);
+        return *this;
+    }
+
+    SegmentedVector& operator=(SegmentedVector&& other)
+    {
+        if(this == &other)
+            return *this;
+        destroyFrom(0);
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+        {
+            if(alloc() != other.alloc())
+            {
+                releaseBlocks();
+                alloc() = other.alloc();
+            }
+        }
+        if(alloc() != other.alloc())
+        {
+            reserve(other.elementCount);
+            for(size_type i = 0; i < other.elementCount; i++)
+                append(std::move(other[i]));
+            return *this;
+        }
+        releaseBlocks();
+        for(unsigned block = 0; block < other.blockCount; block++)
+            blocks[block] = other.blocks[block];
+        blockCount = other.blockCount;
+        elementCount = other.elementCount;
+        other.blockCount = 0;
+        other.elementCount = 0;
+        return *this;
+    }
+
+    allocator_type getAllocator() const
+    {
+        return alloc();
+    }
+
+    bool isEmpty() const
+    {
+        return elementCount == 0;
+    }
+
+    size_type getSize() const
+    {
+        return elementCount;
+    }
+
+    size_type capacity() const
+    {
+        return (FirstBlockLength << blockCount) - FirstBlockLength;
+    }
+
+    // Allocates blocks up front; existing elements stay where they are.
+    void reserve(size_type n)
+    {
+        if(n > MaxCapacity)
+            throw std::length_error("SegmentedVector cannot grow any further");
+        while(capacity() < n)
+            addBlock();
+    }
+
+    void append(const Type& item)
+    {
+        emplaceBack(item);
+    }
+
+    void append(Type&& item)
+    {
+        emplaceBack(std::move(item));
+    }
+
+    void prepend(const Type& item)
+    {
+        emplaceFront(item);
+    }
+
+    void prepend(Type&& item)
+    {
+        emplaceFront(std::move(item));
+    }
+
+    void insert(const const_iterator& insertPosition, const Type& item)
+    {
+        emplace(insertPosition, item);
+    }
+
+    void insert(const const_iterator& insertPosition, Type&& item)
+    {
+        emplace(insertPosition, std::move(item));
+    }
+
+    template <typename... Args>
+    void emplaceBack(Args&&... args)
+    {
+        if(elementCount == capacity())
+            addBlock();
+        AllocTraits::construct(alloc(), slot(elementCount), std::forward<Args>(args)...);
+        elementCount++;
+    }
+
+    template <typename... Args>
+    void emplaceFront(Args&&... args)
+    {
+        emplaceBack(std::forward<Args>(args)...);
+        rotateLastTo(0);
+    }
+
+    template <typename... Args>
+    void emplace(const const_iterator& insertPosition, Args&&... args)
+    {
+        size_type index = checkedIndex(insertPosition, true);
+        emplaceBack(std::forward<Args>(args)...);
+        rotateLastTo(index);
+    }
+
+    Type popFirst()
+    {
+        if(isEmpty())
+            throw std::logic_error("Cannot pop first element when collection is empty");
+        Type result = std::move(*slot(0));
+        removeAt(0, 1);
+        return result;
+    }
+
+    Type popLast()
+    {
+        if(isEmpty())
+            throw std::logic_error("Cannot pop last element when collection is empty");
+        Type result = std::move(*slot(elementCount - 1));
+        destroyFrom(elementCount - 1);
+        return result;
+    }
+
+    void erase(const const_iterator& possition)
+    {
+        removeAt(checkedIndex(possition, false), 1);
+    }
+
+    void erase(const const_iterator& firstIncluded, const const_iterator& lastExcluded)
+    {
+        size_type first = checkedIndex(firstIncluded, true);
+        size_type last = checkedIndex(lastExcluded, true);
+        if(first < last)
+            removeAt(first, last - first);
+    }
+
+    reference operator[](size_type index)
+    {
+        return *slot(index);
+    }
+
+    const_reference operator[](size_type index) const
+    {
+        return *slot(index);
+    }
+
+    // Searches block by block with the same kernels as Vector.
+    const_iterator find(const Type& value) const
+    {
+        difference_type index = indexOf(value);
+        return index < 0 ? cend() : cbegin() + index;
+    }
+
+    iterator find(const Type& value)
+    {
+        return iterator(static_cast<const SegmentedVector*>(this)->find(value));
+    }
+
+    bool contains(const Type& value) const
+    {
+        return indexOf(value) >= 0;
+    }
+
+    size_type count(const Type& value) const
+    {
+        size_type matches = 0;
+        forEachBlock([&](const Type* block, size_type n)
+        {
+            matches += simd::count(block, n, value);
+            return true;
+        });
+        return matches;
+    }
+
+    // Position of the first element equal to value, or -1 when there is none.
+    difference_type indexOf(const Type& value) const
+    {
+        difference_type result = -1;
+        size_type offset = 0;
+        forEachBlock([&](const Type* block, size_type n)
+        {
+            size_type index = simd::findFirst(block, n, value);
+            if(index != n)
+            {
+                result = static_cast<difference_type>(offset + index);
+                return false;
+            }
+            offset += n;
+            return true;
+        });
+        return result;
+    }
+
+    iterator begin()
+    {
+        return iterator(cbegin());
+    }
+
+    iterator end()
+    {
+        return iterator(cend());
+    }
+
+    const_iterator cbegin() const
+    {
+        return ConstIterator(0, this);
+    }
+
+    const_iterator cend() const
+    {
+        return ConstIterator(getSize(), this);
+    }
+
+    const_iterator begin() const
+    {
+        return cbegin();
+    }
+
+    const_iterator end() const
+    {
+        return cend();
+    }
+};
+
+}
+
+#endif // AISDI_LINEAR_SEGMENTEDVECTOR_H
@@ -0,0 +1,215 @@
+#include <SegmentedVector.h>
+#include <Snapshot.h>
+
+#include <initializer_list>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using TestedTypes = boost::mpl::list<std::int32_t, std::uint64_t, std::complex<std::int32_t>>;
+
+template <typename T>
+using LinearCollection = aisdi::SegmentedVector<T, 4>;
+
+using std::begin;
+using std::end;
+
+namespace
+{
+
+template <typename T>
+struct PropagatingAllocator
+{
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+
+  std::shared_ptr<int> live;
+
+  PropagatingAllocator() : live(std::make_shared<int>(0)) {}
+  template <typename U>
+  PropagatingAllocator(const PropagatingAllocator<U>& other) : live(other.live) {}
+
+  T* allocate(std::size_t n)
+  {
+    ++*live;
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n)
+  {
+    --*live;
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  template <typename U>
+  bool operator==(const PropagatingAllocator<U>& other) const { return live == other.live; }
+  template <typename U>
+  bool operator!=(const PropagatingAllocator<U>& other) const { return live != other.live; }
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(SegmentedVectorTests)
+
+template <typename T>
+void thenCollectionContainsValues(const LinearCollection<T>& collection,
+                                  std::initializer_list<int> expected)
+{
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection),
+                                begin(expected), end(expected));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenCreatedWithDefaultConstructor_ThenItIsEmpty,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection;
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK_EQUAL(collection.capacity(), 0);
+  BOOST_CHECK(begin(collection) == end(collection));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenAppendingAcrossBlocks_ThenAddressesStayStable,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection;
+  std::vector<const T*> addresses;
+
+  for(int i = 0; i < 100; ++i)
+  {
+    collection.append(i);
+    addresses.push_back(&collection[i]);
+  }
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 100);
+  BOOST_CHECK_EQUAL(collection.capacity(), 124);
+  for(int i = 0; i < 100; ++i)
+  {
+    BOOST_CHECK(addresses[i] == &collection[i]);
+    BOOST_CHECK_EQUAL(collection[i], T(i));
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenInsertingAndErasing_ThenOrderIsKept,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 2, 4, 5, 6, 7, 8 };
+
+  collection.prepend(1);
+  collection.insert(begin(collection) + 2, 3);
+  collection.append(9);
+  BOOST_CHECK_EQUAL(collection.popFirst(), T(1));
+  BOOST_CHECK_EQUAL(collection.popLast(), T(9));
+  collection.erase(begin(collection) + 1);
+  collection.erase(begin(collection) + 3, begin(collection) + 5);
+
+  thenCollectionContainsValues(collection, { 2, 4, 5, 8 });
+  BOOST_CHECK_THROW(collection.erase(end(collection)), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenSearching_ThenMatchesSpanBlocks,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection;
+  for(int i = 0; i < 40; ++i)
+    collection.append(i % 10);
+
+  BOOST_CHECK_EQUAL(collection.count(T(7)), 4);
+  BOOST_CHECK_EQUAL(collection.indexOf(T(7)), 7);
+  BOOST_CHECK(collection.find(T(11)) == end(collection));
+  BOOST_CHECK(!collection.contains(T(11)));
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenCopyingAndMoving_ThenItemsArePreserved)
+{
+  LinearCollection<std::string> collection = { "a", "b", "c", "d", "e" };
+  const std::string* second = &collection[1];
+
+  LinearCollection<std::string> copy{collection};
+  LinearCollection<std::string> moved{std::move(collection)};
+
+  BOOST_CHECK(&moved[1] == second);
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK_EQUAL(copy.getSize(), 5);
+  BOOST_CHECK_EQUAL(copy[4], "e");
+
+  collection = copy;
+  copy = std::move(moved);
+  BOOST_CHECK_EQUAL(collection[2], "c");
+  BOOST_CHECK(&copy[1] == second);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMoveOnlyItems_WhenEmplacing_ThenItemsAreOwnedByCollection)
+{
+  aisdi::SegmentedVector<std::unique_ptr<int>, 2> collection;
+
+  for(int i = 0; i < 10; ++i)
+    collection.emplaceBack(new int(i));
+  collection.emplaceFront(new int(-1));
+
+  BOOST_CHECK_EQUAL(*collection[0], -1);
+  BOOST_CHECK_EQUAL(*collection.popLast(), 9);
+  BOOST_CHECK_EQUAL(collection.getSize(), 10);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenSavingAndLoadingSnapshot_ThenItemsRoundTrip)
+{
+  LinearCollection<int> collection;
+  for(int i = 0; i < 50; ++i)
+    collection.append(i);
+  std::stringstream stream;
+
+  aisdi::saveTo(collection, stream);
+  LinearCollection<int> loaded = { 7 };
+  aisdi::loadFrom(loaded, stream);
+
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(loaded), end(loaded), begin(collection), end(collection));
+}
+
+BOOST_AUTO_TEST_CASE(GivenUnitFirstBlock_WhenReservingTooMuch_ThenOperationThrows)
+{
+  aisdi::SegmentedVector<int, 1> collection = { 1, 2, 3 };
+
+  BOOST_CHECK_THROW(collection.reserve(std::numeric_limits<std::size_t>::max()), std::length_error);
+  BOOST_CHECK_EQUAL(collection.capacity(), 3);
+  BOOST_CHECK_EQUAL(collection.getSize(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(GivenPropagatingAllocator_WhenAssigning_ThenAllocatorFollowsSource)
+{
+  PropagatingAllocator<int> firstAllocator;
+  PropagatingAllocator<int> secondAllocator;
+  PropagatingAllocator<int> thirdAllocator;
+  aisdi::SegmentedVector<int, 32, PropagatingAllocator<int>> collection({ 1, 2, 3 }, firstAllocator);
+  aisdi::SegmentedVector<int, 32, PropagatingAllocator<int>> source({ 4, 5 }, secondAllocator);
+  aisdi::SegmentedVector<int, 32, PropagatingAllocator<int>> moved({ 6 }, thirdAllocator);
+
+  collection = source;
+
+  BOOST_CHECK_EQUAL(*firstAllocator.live, 0);
+  BOOST_CHECK(collection.getAllocator() == secondAllocator);
+  BOOST_CHECK_EQUAL(collection[1], 5);
+
+  source = std::move(moved);
+
+  BOOST_CHECK(source.getAllocator() == thirdAllocator);
+  BOOST_CHECK_EQUAL(source.getSize(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,159 @@
+#ifndef AISDI_LINEAR_SMALLVECTOR_H
+#define AISDI_LINEAR_SMALLVECTOR_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+#include "Vector.h"
+
+namespace aisdi
+{
+
+template <typename Type, std::size_t N>
+struct SmallVectorStorage
+{
+    alignas(Type) unsigned char inlineBuffer[N * sizeof(Type)];
+};
+
+// Vector that keeps up to N elements inside the object and goes to the heap only past N.
+// The inline buffer is a base listed before Vector, so it outlives the elements stored in it.
+// The Vector base is private: moving or swapping through a Vector& would relocate inline
+// elements behind Vector's noexcept promise. A SmallVector can still be moved into a Vector.
+template <typename Type, std::size_t N = 8>
+class SmallVector : private SmallVectorStorage<Type, N>, private Vector<Type>
+{
+    static_assert(N > 0, "SmallVector needs room for at least one inline element");
+
+    using Storage = SmallVectorStorage<Type, N>;
+    using Base = Vector<Type>;
+
+    friend Base;
+
+public:
+    using difference_type = typename Base::difference_type;
+    using size_type = typename Base::size_type;
+    using value_type = typename Base::value_type;
+    using pointer = typename Base::pointer;
+    using reference = typename Base::reference;
+    using const_pointer = typename Base::const_pointer;
+    using const_reference = typename Base::const_reference;
+    using allocator_type = typename Base::allocator_type;
+
+    using ConstIterator = typename Base::ConstIterator;
+    using Iterator = typename Base::Iterator;
+    using iterator = typename Base::iterator;
+    using const_iterator = typename Base::const_iterator;
+
+    using Base::getAllocator;
+    using Base::isEmpty;
+    using Base::getSize;
+    using Base::append;
+    using Base::prepend;
+    using Base::insert;
+    using Base::emplaceBack;
+    using Base::emplaceFront;
+    using Base::emplace;
+    using Base::popFirst;
+    using Base::popLast;
+    using Base::capacity;
+    using Base::maxSize;
+    using Base::reserve;
+    using Base::resize;
+    using Base::erase;
+    using Base::removeIf;
+    using Base::removeValue;
+    using Base::sort;
+    using Base::stableSort;
+    using Base::data;
+    using Base::find;
+    using Base::contains;
+    using Base::count;
+    using Base::indexOf;
+    using Base::begin;
+    using Base::end;
+    using Base::cbegin;
+    using Base::cend;
+
+    SmallVector()
+        : Base(reinterpret_cast<Type*>(Storage::inlineBuffer), N)
+    {}
+
+    SmallVector(std::initializer_list<Type> l) : SmallVector()
+    {
+        this->reserve(l.size());
+        for(auto it = l.begin(); it != l.end(); ++it)
+            this->append(*it);
+    }
+
+    SmallVector(const SmallVector& other) : SmallVector()
+    {
+        Base::operator=(other);
+    }
+
+    // Steals a heap buffer; elements still held inline are moved one by one.
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible<Type>::value)
+        : SmallVector()
+    {
+        this->moveAssign(other);
+        other.restoreInlineStorage(N);
+    }
+
+    ~SmallVector()
+    {
+        this->erase(this->begin(), this->end());
+    }
+
+    SmallVector& operator=(const SmallVector& other)
+    {
+        Base::operator=(other);
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other)
+    {
+        this->moveAssign(other);
+        other.restoreInlineStorage(N);
+        return *this;
+    }
+
+    void swap(SmallVector& other)
+    {
+        if(this == &other)
+            return;
+        SmallVector temp(std::move(*this));
+        *this = std::move(other);
+        other = std::move(temp);
+    }
+
+    friend void swap(SmallVector& a, SmallVector& b)
+    {
+        a.swap(b);
+    }
+
+    // Returns to the inline buffer once the elements fit in it again.
+    void shrink_to_fit()
+    {
+        if(isSmall())
+            return;
+        if(this->getSize() <= N)
+            this->returnToInlineStorage(N);
+        else
+            Base::shrink_to_fit();
+    }
+
+    static constexpr size_type inlineCapacity()
+    {
+        return N;
+    }
+
+    bool isSmall() const
+    {
+        return this->usesInlineStorage();
+    }
+};
+
+}
+
+#endif // AISDI_LINEAR_SMALLVECTOR_H
@@ -0,0 +1,199 @@
+#include <SmallVector.h>
+
+#include <initializer_list>
+#include <complex>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using TestedTypes = boost::mpl::list<std::int32_t, std::uint64_t, std::complex<std::int32_t>>;
+
+template <typename T>
+using LinearCollection = aisdi::SmallVector<T, 4>;
+
+using std::begin;
+using std::end;
+
+BOOST_AUTO_TEST_SUITE(SmallVectorTests)
+
+template <typename T>
+void thenCollectionContainsValues(const LinearCollection<T>& collection,
+                                  std::initializer_list<int> expected)
+{
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection),
+                                begin(expected), end(expected));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenCreatedWithDefaultConstructor_ThenItIsEmptyAndSmall,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection;
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(collection.isSmall());
+  BOOST_CHECK_EQUAL(collection.capacity(), 4);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenAddingUpToInlineCapacity_ThenItStaysSmall,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection;
+
+  collection.append(2);
+  collection.append(3);
+  collection.prepend(1);
+  collection.append(4);
+
+  BOOST_CHECK(collection.isSmall());
+  thenCollectionContainsValues(collection, { 1, 2, 3, 4 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenFullCollection_WhenAddingItem_ThenItSpillsToHeap,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3, 4 };
+
+  collection.append(5);
+
+  BOOST_CHECK(!collection.isSmall());
+  thenCollectionContainsValues(collection, { 1, 2, 3, 4, 5 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenShrinkingToFit_ThenInlineBufferIsPreferred,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2 };
+
+  collection.shrink_to_fit();
+  BOOST_CHECK(collection.isSmall());
+  BOOST_CHECK_EQUAL(collection.capacity(), 4);
+
+  collection.append(3);
+  collection.append(4);
+  collection.append(5);
+  collection.popFirst();
+  collection.popLast();
+  collection.shrink_to_fit();
+
+  BOOST_CHECK(collection.isSmall());
+  BOOST_CHECK_EQUAL(collection.capacity(), 4);
+  thenCollectionContainsValues(collection, { 2, 3, 4 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSmallCollection_WhenMoving_ThenItemsAreRelocated,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+
+  LinearCollection<T> other{std::move(collection)};
+
+  BOOST_CHECK(other.isSmall());
+  BOOST_CHECK(collection.isEmpty());
+  thenCollectionContainsValues(other, { 1, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSpilledCollection_WhenCopyingAndAssigning_ThenItemsAreCopied,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3, 4, 5, 6 };
+  LinearCollection<T> small = { 7 };
+
+  LinearCollection<T> other{collection};
+  collection = small;
+
+  thenCollectionContainsValues(other, { 1, 2, 3, 4, 5, 6 });
+  thenCollectionContainsValues(collection, { 7 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSmallCollection_WhenMovingIntoVector_ThenVectorOwnsItems,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2 };
+
+  aisdi::Vector<T> vector{std::move(collection)};
+
+  BOOST_CHECK_EQUAL(vector.getSize(), 2);
+  BOOST_CHECK(collection.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenNonTriviallyCopyableType_WhenGrowingAndShrinking_ThenNothingLeaks)
+{
+  aisdi::SmallVector<std::string, 2> collection = { "short", "a string long enough to be allocated" };
+
+  collection.append("spilled to the heap buffer now, also allocated");
+  collection.popFirst();
+  aisdi::SmallVector<std::string, 2> other{std::move(collection)};
+
+  BOOST_CHECK_EQUAL(other.getSize(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(GivenNonTriviallyCopyableType_WhenUsingBothEndsInline_ThenItemsAreSlidInPlace)
+{
+  aisdi::SmallVector<std::string, 4> collection = { "b", "c", "d" };
+
+  collection.prepend("a");
+  collection.popFirst();
+  collection.popFirst();
+  collection.append("e");
+  collection.append("f");
+
+  BOOST_CHECK(collection.isSmall());
+  const std::initializer_list<std::string> expected = { "c", "d", "e", "f" };
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection),
+                                begin(expected), end(expected));
+}
+
+BOOST_AUTO_TEST_CASE(GivenInlineAndHeapCollections_WhenSwapping_ThenItemsAreExchanged)
+{
+  aisdi::SmallVector<std::string, 2> small = { "a" };
+  aisdi::SmallVector<std::string, 2> large = { "b", "c", "d" };
+  const std::string* buffer = large.data();
+
+  swap(small, large);
+
+  BOOST_CHECK(!small.isSmall());
+  BOOST_CHECK(small.data() == buffer);
+  BOOST_CHECK(large.isSmall());
+  const std::initializer_list<std::string> expected = { "b", "c", "d" };
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(small), end(small), begin(expected), end(expected));
+  BOOST_CHECK_EQUAL(large.getSize(), 1);
+  BOOST_CHECK_EQUAL(*begin(large), "a");
+
+  large.swap(small);
+
+  BOOST_CHECK_EQUAL(small.getSize(), 1);
+  BOOST_CHECK_EQUAL(large.getSize(), 3);
+  BOOST_CHECK((std::is_nothrow_move_constructible<aisdi::SmallVector<std::string, 2>>::value));
+}
+
+BOOST_AUTO_TEST_CASE(GivenSmallVector_WhenViewedAsVector_ThenOnlyThrowingMoveIsOffered)
+{
+  using Small = aisdi::SmallVector<std::string, 2>;
+  using Plain = aisdi::Vector<std::string>;
+
+  BOOST_CHECK((!std::is_convertible<Small&, Plain&>::value));
+  BOOST_CHECK((std::is_constructible<Plain, Small&&>::value));
+  BOOST_CHECK((!std::is_nothrow_constructible<Plain, Small&&>::value));
+
+  Small collection = { "a", "b" };
+  Plain vector{std::move(collection)};
+  collection.append("c");
+
+  BOOST_CHECK_EQUAL(vector.getSize(), 2);
+  BOOST_CHECK(collection.isSmall());
+  BOOST_CHECK_EQUAL(*begin(collection), "c");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,479 @@
+#ifndef AISDI_LINEAR_SNAPSHOT_H
+#define AISDI_LINEAR_SNAPSHOT_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include "Vector.h"
+
+namespace aisdi
+{
+
+// Binary snapshots of linear containers: a fixed header followed by the payload. Trivially
+// copyable elements are stored as raw bytes, strings as length-prefixed character runs.
+// The containers do not depend on this header; include it to get saveTo and loadFrom.
+namespace snapshot
+{
+
+constexpr char Magic[8] = {'A', 'I', 'S', 'D', 'I', 'S', 'N', '1'};
+constexpr std::uint32_t RawEncoding = 1;
+constexpr std::uint32_t LengthPrefixedEncoding = 2;
+constexpr std::size_t ChunkBytes = std::size_t(1) << 20;
+
+struct Header
+{
+    char magic[8];
+    std::uint32_t elementSize;
+    std::uint32_t encoding;
+    std::uint64_t count;
+    std::uint64_t payloadBytes;
+    std::uint64_t checksum;
+};
+
+// 64-bit FNV-1a over little-endian 8-byte words; the result does not depend on how the
+// payload is split between update() calls.
+class Checksum
+{
+public:
+    void update(const void* data, std::size_t n)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        while(n > 0 && pendingBytes != 0)
+        {
+            pending[pendingBytes++] = *bytes++;
+            --n;
+            if(pendingBytes == 8)
+                mixPending();
+        }
+        for(; n >= 8; n -= 8, bytes += 8)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, bytes, 8);
+            mix(word);
+        }
+        while(n-- > 0)
+            pending[pendingBytes++] = *bytes++;
+    }
+
+    std::uint64_t value() const
+    {
+        std::uint64_t result = state;
+        for(std::size_t i = 0; i < pendingBytes; ++i)
+            result = (result ^ pending[i]) * Prime;
+        return result;
+    }
+
+private:
+    static constexpr std::uint64_t Prime = 1099511628211ull;
+
+    std::uint64_t state = 14695981039346656037ull;
+    unsigned char pending[8];
+    std::size_t pendingBytes = 0;
+
+    void mix(std::uint64_t word)
+    {
+        state = (state ^ word) * Prime;
+    }
+
+    void mixPending()
+    {
+        std::uint64_t word;
+        std::memcpy(&word, pending, 8);
+        mix(word);
+        pendingBytes = 0;
+    }
+};
+
+inline std::uint64_t checksum(const void* data, std::size_t n)
+{
+    Checksum sum;
+    sum.update(data, n);
+    return sum.value();
+}
+
+class StreamWriter
+{
+public:
+    explicit StreamWriter(std::ostream& stream) : out(stream)
+    {}
+
+    void write(const void* data, std::size_t n)
+    {
+        out.write(static_cast<const char*>(data), n);
+        if(!out)
+            throw std::runtime_error("Cannot write snapshot to stream");
+    }
+
+private:
+    std::ostream& out;
+};
+
+class StreamReader
+{
+public:
+    explicit StreamReader(std::istream& stream) : in(stream)
+    {}
+
+    void read(void* data, std::size_t n)
+    {
+        in.read(static_cast<char*>(data), n);
+        if(static_cast<std::size_t>(in.gcount()) != n)
+            throw std::runtime_error("Snapshot is truncated");
+    }
+
+private:
+    std::istream& in;
+};
+
+class FdWriter
+{
+public:
+    explicit FdWriter(int descriptor) : fd(descriptor)
+    {}
+
+    void write(const void* data, std::size_t n)
+    {
+        const char* bytes = static_cast<const char*>(data);
+        while(n > 0)
+        {
+            ssize_t written = ::write(fd, bytes, n);
+            if(written < 0 && errno == EINTR)
+                continue;
+            if(written < 0)
+                throw std::system_error(errno, std::generic_category(), "Cannot write snapshot");
+            bytes += written;
+            n -= written;
+        }
+    }
+
+private:
+    int fd;
+};
+
+class FdReader
+{
+public:
+    explicit FdReader(int descriptor) : fd(descriptor)
+    {}
+
+    void read(void* data, std::size_t n)
+    {
+        char* bytes = static_cast<char*>(data);
+        while(n > 0)
+        {
+            ssize_t got = ::read(fd, bytes, n);
+            if(got < 0 && errno == EINTR)
+                continue;
+            if(got < 0)
+                throw std::system_error(errno, std::generic_category(), "Cannot read snapshot");
+            if(got == 0)
+                throw std::runtime_error("Snapshot is truncated");
+            bytes += got;
+            n -= got;
+        }
+    }
+
+private:
+    int fd;
+};
+
+// How elements are laid out in the payload. Specialize for other non-trivial types.
+template <typename Type>
+struct Codec
+{
+    static constexpr bool raw = true;
+    static constexpr std::uint32_t encoding = RawEncoding;
+    static constexpr std::uint32_t elementSize = sizeof(Type);
+
+    static_assert(std::is_trivially_copyable<Type>::value,
+                  "Snapshots store trivially copyable types as raw bytes; specialize "
+                  "aisdi::snapshot::Codec for other types");
+};
+
+template <typename Char, typename Traits, typename Allocator>
+struct Codec<std::basic_string<Char, Traits, Allocator>>
+{
+    using String = std::basic_string<Char, Traits, Allocator>;
+
+    static constexpr bool raw = false;
+    static constexpr std::uint32_t encoding = LengthPrefixedEncoding;
+    static constexpr std::uint32_t elementSize = sizeof(Char);
+
+    static void encode(std::string& out, const String& value)
+    {
+        std::uint64_t length = value.size();
+        out.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        out.append(reinterpret_cast<const char*>(value.data()), length * sizeof(Char));
+    }
+
+    static String decode(const char*& cursor, const char* end)
+    {
+        std::uint64_t length;
+        if(end - cursor < static_cast<std::ptrdiff_t>(sizeof(length)))
+            throw std::runtime_error("Snapshot payload is malformed");
+        std::memcpy(&length, cursor, sizeof(length));
+        cursor += sizeof(length);
+        if(static_cast<std::uint64_t>(end - cursor) / sizeof(Char) < length)
+            throw std::runtime_error("Snapshot payload is malformed");
+        String value(length, Char());
+        std::memcpy(&value[0], cursor, length * sizeof(Char));
+        cursor += length * sizeof(Char);
+        return value;
+    }
+};
+
+template <typename Type, typename Writer>
+void writeHeader(Writer& writer, std::uint64_t count, std::uint64_t payloadBytes, std::uint64_t sum)
+{
+    Header header;
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.elementSize = Codec<Type>::elementSize;
+    header.encoding = Codec<Type>::encoding;
+    header.count = count;
+    header.payloadBytes = payloadBytes;
+    header.checksum = sum;
+    writer.write(&header, sizeof(header));
+}
+
+template <typename Type, typename Reader>
+Header readHeader(Reader& reader)
+{
+    Header header;
+    reader.read(&header, sizeof(header));
+    if(std::memcmp(header.magic, Magic, sizeof(Magic)) != 0)
+        throw std::runtime_error("Not a snapshot");
+    if(header.elementSize != Codec<Type>::elementSize || header.encoding != Codec<Type>::encoding)
+        throw std::runtime_error("Snapshot holds a different element type");
+    if(Codec<Type>::raw && (header.count > std::numeric_limits<std::uint64_t>::max() / sizeof(Type)
+                            || header.payloadBytes != header.count * sizeof(Type)))
+        throw std::runtime_error("Snapshot header is inconsistent");
+    return header;
+}
+
+// Writes a contiguous run of raw elements with a single write call.
+template <typename Type, typename Writer>
+void saveContiguous(Writer& writer, const Type* data, std::uint64_t count)
+{
+    std::size_t bytes = count * sizeof(Type);
+    writeHeader<Type>(writer, count, bytes, checksum(data, bytes));
+    if(bytes > 0)
+        writer.write(data, bytes);
+}
+
+// visit(f) must call f(element) for every element, in order.
+template <typename Type, typename Writer, typename Visit>
+void save(Writer& writer, std::uint64_t count, const Visit& visit)
+{
+    if constexpr (Codec<Type>::raw)
+    {
+        Checksum sum;
+        visit([&](const Type& value) { sum.update(&value, sizeof(Type)); });
+        writeHeader<Type>(writer, count, count * sizeof(Type), sum.value());
+
+        std::vector<char> chunk;
+        chunk.reserve(ChunkBytes);
+        visit([&](const Type& value)
+        {
+            const char* bytes = reinterpret_cast<const char*>(&value);
+            chunk.insert(chunk.end(), bytes, bytes + sizeof(Type));
+            if(chunk.size() + sizeof(Type) > ChunkBytes)
+            {
+                writer.write(chunk.data(), chunk.size());
+                chunk.clear();
+            }
+        });
+        if(!chunk.empty())
+            writer.write(chunk.data(), chunk.size());
+    }
+    else
+    {
+        std::string payload;
+        visit([&](const Type& value) { Codec<Type>::encode(payload, value); });
+        writeHeader<Type>(writer, count, payload.size(), checksum(payload.data(), payload.size()));
+        writer.write(payload.data(), payload.size());
+    }
+}
+
+// Calls append(Type&&) for every stored element, reading raw payloads in large chunks.
+template <typename Type, typename Reader, typename Append>
+void load(Reader& reader, const Header& header, const Append& append)
+{
+    Checksum sum;
+    if constexpr (Codec<Type>::raw)
+    {
+        std::size_t perChunk = ChunkBytes / sizeof(Type) > 0 ? ChunkBytes / sizeof(Type) : 1;
+        std::vector<typename std::aligned_storage<sizeof(Type), alignof(Type)>::type> chunk;
+        chunk.resize(header.count < perChunk ? header.count : perChunk);
+        for(std::uint64_t done = 0; done < header.count;)
+        {
+            std::size_t items = header.count - done < perChunk ? header.count - done : perChunk;
+            reader.read(chunk.data(), items * sizeof(Type));
+            sum.update(chunk.data(), items * sizeof(Type));
+            for(std::size_t i = 0; i < items; ++i)
+                append(Type(*std::launder(reinterpret_cast<Type*>(&chunk[i]))));
+            done += items;
+        }
+        if(sum.value() != header.checksum)
+            throw std::runtime_error("Snapshot checksum mismatch");
+    }
+    else
+    {
+        std::string payload(header.payloadBytes, '\0');
+        reader.read(&payload[0], payload.size());
+        sum.update(payload.data(), payload.size());
+        if(sum.value() != header.checksum)
+            throw std::runtime_error("Snapshot checksum mismatch");
+        const char* cursor = payload.data();
+        const char* end = cursor + payload.size();
+        for(std::uint64_t i = 0; i < header.count; ++i)
+            append(Codec<Type>::decode(cursor, end));
+    }
+}
+
+template <typename Container, typename = void>
+struct HasReserve : std::false_type
+{};
+
+template <typename Container>
+struct HasReserve<Container, std::void_t<decltype(std::declval<Container&>().reserve(std::size_t()))>>
+    : std::true_type
+{};
+
+// Saves any container through its public interface.
+template <typename Writer, typename Container>
+void saveElements(Writer& writer, const Container& container)
+{
+    using Type = typename Container::value_type;
+    save<Type>(writer, container.getSize(), [&container](const auto& f)
+    {
+        for(auto it = container.begin(); it != container.end(); ++it)
+            f(*it);
+    });
+}
+
+// Loads any container through its public interface: erase, reserve when present, append.
+template <typename Reader, typename Container>
+void loadElements(Reader& reader, Container& container)
+{
+    using Type = typename Container::value_type;
+    container.erase(container.begin(), container.end());
+    Header header = readHeader<Type>(reader);
+    if constexpr (HasReserve<Container>::value)
+        container.reserve(header.count);
+    try
+    {
+        load<Type>(reader, header, [&container](Type&& item) { container.append(std::move(item)); });
+    }
+    catch(...)
+    {
+        container.erase(container.begin(), container.end());
+        throw;
+    }
+}
+
+}
+
+// How saveTo and loadFrom reach a container; specialize to bypass the public interface.
+template <typename Container>
+struct SnapshotAccess
+{
+    template <typename Writer>
+    static void save(Writer& writer, const Container& container)
+    {
+        snapshot::saveElements(writer, container);
+    }
+
+    template <typename Reader>
+    static void load(Reader& reader, Container& container)
+    {
+        snapshot::loadElements(reader, container);
+    }
+};
+
+// Vector saves a raw payload with a single write and reads it straight into a buffer sized
+// once from the header.
+template <typename Type, std::size_t InitialCapacity, typename Allocator, typename GrowthPolicy,
+          typename IteratorPolicy, typename Statistics>
+struct SnapshotAccess<Vector<Type, InitialCapacity, Allocator, GrowthPolicy, IteratorPolicy, Statistics>>
+{
+    using Container = Vector<Type, InitialCapacity, Allocator, GrowthPolicy, IteratorPolicy, Statistics>;
+
+    template <typename Writer>
+    static void save(Writer& writer, const Container& container)
+    {
+        if constexpr (snapshot::Codec<Type>::raw)
+            snapshot::saveContiguous(writer, container.data(), container.getSize());
+        else
+            snapshot::saveElements(writer, container);
+    }
+
+    template <typename Reader>
+    static void load(Reader& reader, Container& container)
+    {
+        if constexpr (snapshot::Codec<Type>::raw)
+        {
+            container.erase(container.begin(), container.end());
+            snapshot::Header header = snapshot::readHeader<Type>(reader);
+            container.reserve(header.count);
+            if(header.count == 0)
+                return;
+            reader.read(container.array, header.payloadBytes);
+            if(snapshot::checksum(container.array, header.payloadBytes) != header.checksum)
+                throw std::runtime_error("Snapshot checksum mismatch");
+            container.nonitem = header.count;
+        }
+        else
+        {
+            snapshot::loadElements(reader, container);
+        }
+    }
+};
+
+// Writes a binary snapshot of container.
+template <typename Container>
+void saveTo(const Container& container, std::ostream& out)
+{
+    snapshot::StreamWriter writer(out);
+    SnapshotAccess<Container>::save(writer, container);
+}
+
+template <typename Container>
+void saveTo(const Container& container, int fd)
+{
+    snapshot::FdWriter writer(fd);
+    SnapshotAccess<Container>::save(writer, container);
+}
+
+// Replaces the contents of container with a snapshot. On any error it throws and leaves
+// the container empty.
+template <typename Container>
+void loadFrom(Container& container, std::istream& in)
+{
+    snapshot::StreamReader reader(in);
+    SnapshotAccess<Container>::load(reader, container);
+}
+
+template <typename Container>
+void loadFrom(Container& container, int fd)
+{
+    snapshot::FdReader reader(fd);
+    SnapshotAccess<Container>::load(reader, container);
+}
+
+}
+
+#endif // AISDI_LINEAR_SNAPSHOT_H
@@ -0,0 +1,309 @@
+#ifndef AISDI_LINEAR_SORTKERNELS_H
+#define AISDI_LINEAR_SORTKERNELS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace aisdi
+{
+
+namespace sorting
+{
+
+// Ranges at most this long are finished with insertion sort.
+constexpr std::ptrdiff_t InsertionThreshold = 16;
+
+// Below this many elements radix sort loses to introsort on its fixed passes.
+constexpr std::size_t RadixThreshold = 256;
+
+template <typename Type, typename Compare>
+void insertionSort(Type* first, Type* last, Compare& cmp)
+{
+    if(first == last)
+        return;
+    for(Type* curr = first + 1; curr != last; ++curr)
+    {
+        if(!cmp(*curr, *(curr - 1)))
+            continue;
+        Type item = std::move(*curr);
+        Type* hole = curr;
+        do
+        {
+            *hole = std::move(*(hole - 1));
+            --hole;
+        }
+        while(hole != first && cmp(item, *(hole - 1)));
+        *hole = std::move(item);
+    }
+}
+
+template <typename Type, typename Compare>
+void siftDown(Type* heap, std::ptrdiff_t hole, std::ptrdiff_t length, Compare& cmp)
+{
+    Type item = std::move(heap[hole]);
+    for(std::ptrdiff_t child = 2 * hole + 1; child < length; child = 2 * hole + 1)
+    {
+        if(child + 1 < length && cmp(heap[child], heap[child + 1]))
+            ++child;
+        if(!cmp(item, heap[child]))
+            break;
+        heap[hole] = std::move(heap[child]);
+        hole = child;
+    }
+    heap[hole] = std::move(item);
+}
+
+template <typename Type, typename Compare>
+void heapSort(Type* first, Type* last, Compare& cmp)
+{
+    std::ptrdiff_t length = last - first;
+    for(std::ptrdiff_t i = length / 2; i-- > 0;)
+        siftDown(first, i, length, cmp);
+    while(length > 1)
+    {
+        --length;
+        std::swap(first[0], first[length]);
+        siftDown(first, 0, length, cmp);
+    }
+}
+
+// Orders *a <= *b <= *c.
+template <typename Type, typename Compare>
+void sortThree(Type* a, Type* b, Type* c, Compare& cmp)
+{
+    if(cmp(*b, *a))
+        std::swap(*a, *b);
+    if(cmp(*c, *b))
+    {
+        std::swap(*b, *c);
+        if(cmp(*b, *a))
+            std::swap(*a, *b);
+    }
+}
+
+template <typename Type, typename Compare>
+void introsortLoop(Type* first, Type* last, int depth, Compare& cmp)
+{
+    while(last - first > InsertionThreshold)
+    {
+        if(depth-- == 0)
+        {
+            heapSort(first, last, cmp);
+            return;
+        }
+        // Median of three lands in first + 1; first and last - 1 bound both scans.
+        Type* middle = first + (last - first) / 2;
+        sortThree(first, middle, last - 1, cmp);
+        std::swap(*middle, first[1]);
+        Type* pivot = first + 1;
+        Type* left = first + 2;
+        Type* right = last - 2;
+        while(true)
+        {
+            while(cmp(*left, *pivot))
+                ++left;
+            while(cmp(*pivot, *right))
+                --right;
+            if(left >= right)
+                break;
+            std::swap(*left, *right);
+            ++left;
+            --right;
+        }
+        std::swap(*pivot, *right);
+        // Recurse into the smaller side so the stack stays logarithmic.
+        if(right - first < last - right)
+        {
+            introsortLoop(first, right, depth, cmp);
+            first = right + 1;
+        }
+        else
+        {
+            introsortLoop(right + 1, last, depth, cmp);
+            last = right;
+        }
+    }
+    insertionSort(first, last, cmp);
+}
+
+// Quicksort with median-of-three pivots that falls back to heapsort once recursion passes
+// 2*log2(n), so the worst case stays O(n log n). Not stable.
+template <typename Type, typename Compare>
+void introsort(Type* first, Type* last, Compare cmp)
+{
+    int depth = 0;
+    for(std::ptrdiff_t n = last - first; n > 1; n >>= 1)
+        depth += 2;
+    introsortLoop(first, last, depth, cmp);
+}
+
+// Uninitialized scratch space for length elements; destroys whatever was constructed.
+template <typename Type>
+class ScratchBuffer
+{
+    Type* buffer;
+    std::size_t constructed;
+
+public:
+    explicit ScratchBuffer(std::size_t length)
+        : buffer(static_cast<Type*>(::operator new(length * sizeof(Type), std::align_val_t(alignof(Type))))),
+          constructed(0)
+    {}
+
+    ScratchBuffer(const ScratchBuffer&) = delete;
+    ScratchBuffer& operator=(const ScratchBuffer&) = delete;
+
+    ~ScratchBuffer()
+    {
+        clear();
+        ::operator delete(buffer, std::align_val_t(alignof(Type)));
+    }
+
+    Type* data()
+    {
+        return buffer;
+    }
+
+    // Moves [first, last) into the start of the buffer.
+    void fill(Type* first, Type* last)
+    {
+        clear();
+        for(; first != last; ++first, ++constructed)
+            ::new (static_cast<void*>(buffer + constructed)) Type(std::move(*first));
+    }
+
+    void clear()
+    {
+        if(!std::is_trivially_destructible<Type>::value)
+            for(std::size_t i = 0; i < constructed; i++)
+                buffer[i].~Type();
+        constructed = 0;
+    }
+};
+
+// Stable merge of the adjacent runs [first, middle) and [middle, last). The shorter run is
+// parked in scratch, which must hold half the combined length rounded up.
+template <typename Type, typename Compare>
+void mergeRuns(Type* first, Type* middle, Type* last, ScratchBuffer<Type>& scratch, Compare& cmp)
+{
+    if(middle == last || !cmp(*middle, *(middle - 1)))
+        return;
+    if(middle - first <= last - middle)
+    {
+        scratch.fill(first, middle);
+        Type* left = scratch.data();
+        Type* leftEnd = left + (middle - first);
+        Type* right = middle;
+        Type* out = first;
+        while(left != leftEnd && right != last)
+        {
+            if(cmp(*right, *left))
+                *out++ = std::move(*right++);
+            else
+                *out++ = std::move(*left++);
+        }
+        while(left != leftEnd)
+            *out++ = std::move(*left++);
+    }
+    else
+    {
+        scratch.fill(middle, last);
+        Type* rightBegin = scratch.data();
+        Type* right = rightBegin + (last - middle);
+        Type* left = middle;
+        Type* out = last;
+        while(left != first && right != rightBegin)
+        {
+            if(cmp(*(right - 1), *(left - 1)))
+                *--out = std::move(*--left);
+            else
+                *--out = std::move(*--right);
+        }
+        while(right != rightBegin)
+            *--out = std::move(*--right);
+    }
+    scratch.clear();
+}
+
+// Bottom-up merge sort: insertion-sorted runs, then merges of doubling width. Stable; uses
+// scratch space for half the range.
+template <typename Type, typename Compare>
+void mergeSort(Type* first, Type* last, Compare cmp)
+{
+    std::ptrdiff_t length = last - first;
+    for(std::ptrdiff_t run = 0; run < length; run += InsertionThreshold)
+        insertionSort(first + run, first + std::min(run + InsertionThreshold, length), cmp);
+    if(length <= InsertionThreshold)
+        return;
+
+    ScratchBuffer<Type> scratch(length / 2 + 1);
+    for(std::ptrdiff_t width = InsertionThreshold; width < length; width *= 2)
+        for(std::ptrdiff_t left = 0; left + width < length; left += 2 * width)
+            mergeRuns(first + left, first + left + width, first + std::min(left + 2 * width, length),
+                      scratch, cmp);
+}
+
+// True when cmp is the natural ascending order of an integral Type, which radix sort
+// reproduces exactly.
+template <typename Type, typename Compare>
+constexpr bool radixApplies()
+{
+    return std::is_integral<Type>::value && !std::is_same<Type, bool>::value
+           && (std::is_same<Compare, std::less<Type>>::value || std::is_same<Compare, std::less<>>::value);
+}
+
+// LSD radix sort on bytes. Signed keys get their sign bit flipped so that they order as
+// unsigned ones. Byte positions where every key agrees are skipped. Stable.
+template <typename Type>
+void radixSort(Type* first, Type* last)
+{
+    using Key = typename std::make_unsigned<Type>::type;
+    constexpr Key SignFlip = std::is_signed<Type>::value ? Key(Key(1) << (sizeof(Key) * 8 - 1)) : Key(0);
+    std::size_t length = last - first;
+    std::unique_ptr<Type[]> scratch(new Type[length]);
+
+    std::size_t counts[sizeof(Key)][256] = {};
+    for(Type* it = first; it != last; ++it)
+    {
+        Key key = static_cast<Key>(*it) ^ SignFlip;
+        for(std::size_t byte = 0; byte < sizeof(Key); byte++)
+            counts[byte][(key >> (byte * 8)) & 0xff]++;
+    }
+
+    Type* from = first;
+    Type* to = scratch.get();
+    for(std::size_t byte = 0; byte < sizeof(Key); byte++)
+    {
+        std::size_t* count = counts[byte];
+        Key sample = static_cast<Key>(*first) ^ SignFlip;
+        if(count[(sample >> (byte * 8)) & 0xff] == length)
+            continue;
+        std::size_t offset = 0;
+        for(std::size_t digit = 0; digit < 256; digit++)
+        {
+            std::size_t n = count[digit];
+            count[digit] = offset;
+            offset += n;
+        }
+        for(std::size_t i = 0; i < length; i++)
+        {
+            Key key = static_cast<Key>(from[i]) ^ SignFlip;
+            to[count[(key >> (byte * 8)) & 0xff]++] = from[i];
+        }
+        std::swap(from, to);
+    }
+    if(from != first)
+        std::memcpy(first, from, length * sizeof(Type));
+}
+
+}
+
+}
+
+#endif // AISDI_LINEAR_SORTKERNELS_H
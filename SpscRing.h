@@ -0,0 +1,207 @@
+#ifndef AISDI_LINEAR_SPSCRING_H
+#define AISDI_LINEAR_SPSCRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "AlignedAllocator.h"
+
+namespace aisdi
+{
+
+// Bounded queue handing elements from exactly one producer thread to exactly one consumer
+// thread without locks. The capacity is rounded up to a power of two so positions wrap
+// with a mask. Slots come from the same allocator Vector uses by default.
+//
+// head is written only by the consumer and tail only by the producer, each on its own
+// cache line. Each side also keeps a private copy of the other side's index and reloads
+// it only when the ring looks full (producer) or empty (consumer), so most operations
+// touch no shared cache line besides the slot itself. pushN/popN publish a whole batch
+// with a single release store.
+template <typename Type, typename Allocator = DefaultAllocator<Type>>
+class SpscRing : private Allocator
+{
+public:
+    using size_type = std::size_t;
+    using value_type = Type;
+    using allocator_type = Allocator;
+
+    static constexpr size_type CacheLineSize = 64;
+
+private:
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    struct alignas(CacheLineSize) ProducerSide
+    {
+        std::atomic<size_type> tail;
+        size_type cachedHead;
+    };
+
+    struct alignas(CacheLineSize) ConsumerSide
+    {
+        std::atomic<size_type> head;
+        size_type cachedTail;
+    };
+
+    Type* slots;
+    size_type mask;
+    ProducerSide producer;
+    ConsumerSide consumer;
+
+    Allocator& alloc()
+    {
+        return *this;
+    }
+
+    static size_type roundUp(size_type n)
+    {
+        if(n > std::numeric_limits<size_type>::max() / 2 + 1)
+            throw std::length_error("SpscRing capacity has no power of two to round up to");
+        size_type capacity = 1;
+        while(capacity < n)
+            capacity <<= 1;
+        return capacity;
+    }
+
+    // Free slots as seen by the producer; refreshes the cached head only when needed.
+    size_type freeSlots(size_type wanted)
+    {
+        size_type tail = producer.tail.load(std::memory_order_relaxed);
+        size_type free = capacity() - (tail - producer.cachedHead);
+        if(free < wanted)
+        {
+            producer.cachedHead = consumer.head.load(std::memory_order_acquire);
+            free = capacity() - (tail - producer.cachedHead);
+        }
+        return free;
+    }
+
+    // Published elements as seen by the consumer; refreshes the cached tail only when needed.
+    size_type readySlots(size_type wanted)
+    {
+        size_type head = consumer.head.load(std::memory_order_relaxed);
+        size_type ready = consumer.cachedTail - head;
+        if(ready < wanted)
+        {
+            consumer.cachedTail = producer.tail.load(std::memory_order_acquire);
+            ready = consumer.cachedTail - head;
+        }
+        return ready;
+    }
+
+public:
+    explicit SpscRing(size_type minimalCapacity, const Allocator& allocator = Allocator())
+        : Allocator(allocator)
+    {
+        if(minimalCapacity == 0)
+            throw std::invalid_argument("SpscRing needs a non-zero capacity");
+        size_type capacity = roundUp(minimalCapacity);
+        slots = AllocTraits::allocate(alloc(), capacity);
+        mask = capacity - 1;
+        producer.tail.store(0, std::memory_order_relaxed);
+        producer.cachedHead = 0;
+        consumer.head.store(0, std::memory_order_relaxed);
+        consumer.cachedTail = 0;
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    ~SpscRing()
+    {
+        size_type head = consumer.head.load(std::memory_order_relaxed);
+        size_type tail = producer.tail.load(std::memory_order_relaxed);
+        for(; head != tail; head++)
+            AllocTraits::destroy(alloc(), slots + (head & mask));
+        AllocTraits::deallocate(alloc(), slots, mask + 1);
+    }
+
+    size_type capacity() const
+    {
+        return mask + 1;
+    }
+
+    // Approximate when called while the other side is running.
+    size_type getSize() const
+    {
+        return producer.tail.load(std::memory_order_acquire) - consumer.head.load(std::memory_order_acquire);
+    }
+
+    bool isEmpty() const
+    {
+        return getSize() == 0;
+    }
+
+    // Producer side. Returns false without constructing anything when the ring is full.
+    template <typename... Args>
+    bool tryEmplace(Args&&... args)
+    {
+        if(freeSlots(1) == 0)
+            return false;
+        size_type tail = producer.tail.load(std::memory_order_relaxed);
+        AllocTraits::construct(alloc(), slots + (tail & mask), std::forward<Args>(args)...);
+        producer.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPush(const Type& item)
+    {
+        return tryEmplace(item);
+    }
+
+    bool tryPush(Type&& item)
+    {
+        return tryEmplace(std::move(item));
+    }
+
+    // Producer side. Copies up to n items and returns how many fit.
+    size_type pushN(const Type* items, size_type n)
+    {
+        size_type free = freeSlots(n);
+        if(n > free)
+            n = free;
+        size_type tail = producer.tail.load(std::memory_order_relaxed);
+        for(size_type i = 0; i < n; i++)
+            AllocTraits::construct(alloc(), slots + ((tail + i) & mask), items[i]);
+        producer.tail.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    // Consumer side. Returns false and leaves item untouched when the ring is empty.
+    bool tryPop(Type& item)
+    {
+        if(readySlots(1) == 0)
+            return false;
+        size_type head = consumer.head.load(std::memory_order_relaxed);
+        Type* slot = slots + (head & mask);
+        item = std::move(*slot);
+        AllocTraits::destroy(alloc(), slot);
+        consumer.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Moves up to n items into out and returns how many were available.
+    size_type popN(Type* out, size_type n)
+    {
+        size_type ready = readySlots(n);
+        if(n > ready)
+            n = ready;
+        size_type head = consumer.head.load(std::memory_order_relaxed);
+        for(size_type i = 0; i < n; i++)
+        {
+            Type* slot = slots + ((head + i) & mask);
+            out[i] = std::move(*slot);
+            AllocTraits::destroy(alloc(), slot);
+        }
+        consumer.head.store(head + n, std::memory_order_release);
+        return n;
+    }
+};
+
+}
+
+#endif // AISDI_LINEAR_SPSCRING_H
@@ -0,0 +1,104 @@
+#include <SpscRing.h>
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+BOOST_AUTO_TEST_SUITE(SpscRingTests)
+
+BOOST_AUTO_TEST_CASE(GivenRing_WhenCreated_ThenCapacityIsRoundedToPowerOfTwo)
+{
+  aisdi::SpscRing<int> ring(5);
+
+  BOOST_CHECK_EQUAL(ring.capacity(), 8);
+  BOOST_CHECK(ring.isEmpty());
+  BOOST_CHECK_THROW(aisdi::SpscRing<int>(0), std::invalid_argument);
+  BOOST_CHECK_THROW(aisdi::SpscRing<int>(SIZE_MAX), std::length_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenFullRing_WhenPushing_ThenItemIsRejected)
+{
+  aisdi::SpscRing<std::string> ring(2);
+  std::string item;
+
+  BOOST_CHECK(ring.tryPush("a"));
+  BOOST_CHECK(ring.tryPush("b"));
+  BOOST_CHECK(!ring.tryPush("c"));
+  BOOST_CHECK(ring.tryPop(item));
+  BOOST_CHECK_EQUAL(item, "a");
+  BOOST_CHECK(ring.tryPush("c"));
+  BOOST_CHECK(ring.tryPop(item));
+  BOOST_CHECK(ring.tryPop(item));
+  BOOST_CHECK_EQUAL(item, "c");
+  BOOST_CHECK(!ring.tryPop(item));
+}
+
+BOOST_AUTO_TEST_CASE(GivenRing_WhenPushingAndPoppingBatches_ThenOrderIsKeptAcrossWrap)
+{
+  aisdi::SpscRing<int> ring(8);
+  int in[6] = { 1, 2, 3, 4, 5, 6 };
+  int out[8] = {};
+
+  BOOST_CHECK_EQUAL(ring.pushN(in, 6), 6);
+  BOOST_CHECK_EQUAL(ring.popN(out, 4), 4);
+  BOOST_CHECK_EQUAL(ring.pushN(in, 6), 6);
+  BOOST_CHECK_EQUAL(ring.pushN(in, 6), 0);
+  BOOST_CHECK_EQUAL(ring.popN(out, 8), 8);
+
+  int expected[8] = { 5, 6, 1, 2, 3, 4, 5, 6 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(out, out + 8, expected, expected + 8);
+}
+
+BOOST_AUTO_TEST_CASE(GivenItemsLeftInRing_WhenDestroyed_ThenTheyAreReleased)
+{
+  auto shared = std::make_shared<int>(1);
+  {
+    aisdi::SpscRing<std::shared_ptr<int>> ring(4);
+    ring.tryPush(shared);
+    ring.tryPush(shared);
+    BOOST_CHECK_EQUAL(shared.use_count(), 3);
+  }
+  BOOST_CHECK_EQUAL(shared.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenProducerAndConsumerThreads_WhenHandingOff_ThenEveryItemArrivesInOrder)
+{
+  const std::uint64_t count = 200000;
+  aisdi::SpscRing<std::uint64_t> ring(64);
+
+  std::thread producer([&]
+  {
+    std::uint64_t batch[16];
+    for(std::uint64_t next = 0; next < count; )
+    {
+      std::uint64_t n = 0;
+      for(; n < 16 && next + n < count; ++n)
+        batch[n] = next + n;
+      std::uint64_t pushed = ring.pushN(batch, n);
+      if(pushed == 0)
+        std::this_thread::yield();
+      next += pushed;
+    }
+  });
+
+  bool ordered = true;
+  std::uint64_t expected = 0;
+  std::uint64_t item;
+  while(expected < count)
+    if(ring.tryPop(item))
+      ordered = ordered && item == expected++;
+    else
+      std::this_thread::yield();
+  producer.join();
+
+  BOOST_CHECK(ordered);
+  BOOST_CHECK(ring.isEmpty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
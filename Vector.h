@@ -1,18 +1,45 @@
 #ifndef AISDI_LINEAR_VECTOR_H
 #define AISDI_LINEAR_VECTOR_H
 
-#define ARRAYLENGTH 40
 #include <cstddef>
+#include <cstring>
+#include <functional>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <numeric>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
+#include "AlignedAllocator.h"
+#include "GrowthPolicy.h"
+#include "IteratorPolicy.h"
+#include "SearchKernels.h"
+#include "SortKernels.h"
 
 namespace aisdi
 {
 
-template <typename Type>
-class Vector
+template <typename Type, std::size_t N>
+class SmallVector;
+
+// InitialCapacity is the size of the first buffer, allocated on first insertion; after that
+// GrowthPolicy (see GrowthPolicy.h) picks every larger capacity. IteratorPolicy (see
+// IteratorPolicy.h) decides whether iterators check their bounds. Statistics (see
+// GrowthPolicy.h) optionally counts reallocations and bytes moved.
+// The allocator and the statistics are private bases so that stateless ones take no space;
+// the allocator's alignment carries over every reallocation, and growth places the elements
+// at an offset that keeps it (see DefaultAllocator).
+template <typename Type, std::size_t InitialCapacity = 40, typename Allocator = DefaultAllocator<Type>,
+          typename GrowthPolicy = DoublingGrowth, typename IteratorPolicy = DefaultIteratorPolicy,
+          typename Statistics = NoGrowthStatistics>
+class Vector : private Allocator, private Statistics
 {
+    static_assert(InitialCapacity > 0, "Vector needs a non-zero initial capacity");
+
 public:
     using difference_type = std::ptrdiff_t;
     using size_type = std::size_t;
@@ -21,6 +48,7 @@ public:
     using reference = Type&;
     using const_pointer = const Type*;
     using const_reference = const Type&;
+    using allocator_type = Allocator;
 
     class ConstIterator;
     class Iterator;
@@ -28,93 +56,640 @@ public:
     using const_iterator = ConstIterator;
 
 private:
-    int length;
-    int nonitem;
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    // Snapshot.h reads raw payloads straight into the buffer.
+    template <typename> friend struct SnapshotAccess;
+
+    size_type length;
+    size_type nonitem;
+    Type* storage;
     Type* array;
+    Type* inlineStorage;
+
+    // storage is raw memory of length slots; only [array, array + nonitem) hold constructed
+    // objects. The free slots before array let prepend and popFirst run in amortized O(1).
+    Allocator& alloc()
+    {
+        return *this;
+    }
+
+    const Allocator& alloc() const
+    {
+        return *this;
+    }
+
+    Statistics& stats()
+    {
+        return *this;
+    }
+
+    const Statistics& stats() const
+    {
+        return *this;
+    }
+
+    Type* allocate(size_type n)
+    {
+        if(n == 0)
+            return nullptr;
+        return AllocTraits::allocate(alloc(), n);
+    }
+
+    void deallocate(Type* p, size_type n)
+    {
+        if(p != nullptr)
+            AllocTraits::deallocate(alloc(), p, n);
+    }
+
+    // A buffer handed in by a derived container is never freed by Vector.
+    void releaseStorage()
+    {
+        if(storage != inlineStorage)
+            deallocate(storage, length);
+    }
+
+    template <typename... Args>
+    void construct(Type* p, Args&&... args)
+    {
+        AllocTraits::construct(alloc(), p, std::forward<Args>(args)...);
+    }
+
+    void destroy(Type* first, Type* last)
+    {
+        if (!std::is_trivially_destructible<Type>::value)
+            for(; first != last; ++first)
+                AllocTraits::destroy(alloc(), first);
+    }
+
+    // Moves [first, last) into uninitialized dest and destroys the sources.
+    void relocate(Type* first, Type* last, Type* dest)
+    {
+        if (first == last)
+            return;
+        if constexpr (std::is_trivially_copyable<Type>::value)
+        {
+            std::memcpy(static_cast<void*>(dest), first, (last - first) * sizeof(Type));
+        }
+        else
+        {
+            Type* curr = dest;
+            try
+            {
+                for(Type* it = first; it != last; ++it, ++curr)
+                    construct(curr, std::move_if_noexcept(*it));
+            }
+            catch(...)
+            {
+                destroy(dest, curr);
+                throw;
+            }
+            destroy(first, last);
+        }
+    }
+
+    // Move-assigns [first, last) onto the range starting at dest, which may overlap it.
+    // Trivially copyable types are moved with a single memmove.
+    static void moveRange(Type* first, Type* last, Type* dest)
+    {
+        if (first == last)
+            return;
+        if constexpr (std::is_trivially_copyable<Type>::value)
+        {
+            std::memmove(static_cast<void*>(dest), first, (last - first) * sizeof(Type));
+        }
+        else if (dest < first)
+        {
+            for(; first != last; ++first, ++dest)
+                *dest = std::move(*first);
+        }
+        else
+        {
+            dest += last - first;
+            while(last != first)
+                *--dest = std::move(*--last);
+        }
+    }
+
+    size_type frontRoom() const
+    {
+        return array - storage;
+    }
+
+    size_type backRoom() const
+    {
+        return length - frontRoom() - nonitem;
+    }
+
+    // Capacity to grow to when the current buffer cannot hold required elements. A policy
+    // result that wrapped around or exceeds maxSize() is clamped to maxSize().
+    size_type grownLength(size_type required) const
+    {
+        size_type limit = maxSize();
+        if(required > limit)
+            throw std::length_error("Vector cannot grow beyond maxSize()");
+        size_type grown = length == 0 ? InitialCapacity : GrowthPolicy()(length, required);
+        if(grown < length || grown > limit)
+            grown = limit;
+        return grown > required ? grown : required;
+    }
+
+    void reallocate(size_type newLength, size_type newHead = 0)
+    {
+        Type* newStorage = allocate(newLength);
+        try
+        {
+            relocate(array, array + nonitem, newStorage + newHead);
+        }
+        catch(...)
+        {
+            deallocate(newStorage, newLength);
+            throw;
+        }
+        if(length > 0)
+            stats().recordReallocation();
+        stats().recordMove(nonitem * sizeof(Type));
+        releaseStorage();
+        storage = newStorage;
+        array = newStorage + newHead;
+        length = newLength;
+    }
+
+    // Unlike reserve, growth to fit n elements follows GrowthPolicy, so repeated small
+    // resizes stay amortized O(1).
+    void growFor(size_type n)
+    {
+        if(n > capacity())
+            reallocate(grownLength(n));
+    }
+
+    // Moves the elements to offset newHead of the current buffer; the ranges may overlap.
+    void slideTo(size_type newHead)
+    {
+        Type* dest = storage + newHead;
+        Type* oldEnd = array + nonitem;
+        if(dest == array)
+            return;
+        stats().recordMove(nonitem * sizeof(Type));
+        if constexpr (std::is_trivially_copyable<Type>::value)
+        {
+            moveRange(array, oldEnd, dest);
+        }
+        else if(dest > array)
+        {
+            for(size_type i = nonitem; i-- > 0;)
+                if(dest + i >= oldEnd)
+                    construct(dest + i, std::move(array[i]));
+                else
+                    dest[i] = std::move(array[i]);
+            destroy(array, dest < oldEnd ? dest : oldEnd);
+        }
+        else
+        {
+            for(size_type i = 0; i < nonitem; i++)
+                if(dest + i < array)
+                    construct(dest + i, std::move(array[i]));
+                else
+                    dest[i] = std::move(array[i]);
+            destroy(dest + nonitem > array ? dest + nonitem : array, oldEnd);
+        }
+        array = dest;
+    }
+
+    // Element offsets that are multiples of AlignmentStep keep the allocator's alignment.
+    static constexpr size_type AlignmentStep = AllocatorAlignment<Allocator>::value
+        / std::gcd(AllocatorAlignment<Allocator>::value, sizeof(Type));
+
+    // The aligned offset nearest below head that is at least minimum, else the one above it
+    // if that is at most maximum, else head itself.
+    static size_type alignHead(size_type head, size_type minimum, size_type maximum)
+    {
+        size_type down = head - head % AlignmentStep;
+        if(down >= minimum)
+            return down;
+        if(down + AlignmentStep <= maximum)
+            return down + AlignmentStep;
+        return head;
+    }
+
+    // Sliding within the buffer pays off when it frees at least as many slots as it moves,
+    // and always beats leaving an inline buffer.
+    bool worthSliding(size_type spare) const
+    {
+        return spare > 0 && (spare >= 2*nonitem || usesInlineStorage());
+    }
+
+    // Front growth centres the elements so both ends keep spare room. When enough of the
+    // buffer is idle at the back, the elements are slid instead.
+    void makeRoomAtFront()
+    {
+        size_type spare = backRoom();
+        if(worthSliding(spare))
+        {
+            slideTo(alignHead(spare - spare/2, 1, spare));
+            return;
+        }
+        size_type newLength = grownLength(nonitem + 1);
+        size_type room = newLength - nonitem;
+        reallocate(newLength, alignHead(room - room/2, 1, room));
+    }
+
+    // Opens a slot at pos (the shorter side must already have room) and stores item there.
+    template <typename Arg>
+    void insertAt(size_type pos, bool atFront, Arg&& item)
+    {
+        if constexpr (std::is_trivially_copyable<Type>::value)
+        {
+            if(atFront)
+            {
+                moveRange(array, array + pos, array - 1);
+                --array;
+            }
+            else
+            {
+                moveRange(array + pos, array + nonitem, array + pos + 1);
+            }
+            construct(array + pos, std::forward<Arg>(item));
+        }
+        else if(atFront)
+        {
+            if(pos == 0)
+            {
+                construct(array - 1, std::forward<Arg>(item));
+            }
+            else
+            {
+                construct(array - 1, std::move(array[0]));
+                moveRange(array + 1, array + pos, array);
+                array[pos-1] = std::forward<Arg>(item);
+            }
+            --array;
+        }
+        else if(pos == nonitem)
+        {
+            construct(array + nonitem, std::forward<Arg>(item));
+        }
+        else
+        {
+            construct(array + nonitem, std::move(array[nonitem-1]));
+            moveRange(array + pos, array + nonitem - 1, array + pos + 1);
+            array[pos] = std::forward<Arg>(item);
+        }
+        nonitem++;
+    }
+
+    // args may refer into the buffer, so growth and mid-buffer insertion go through a temporary.
+    // An end with free room is constructed into directly.
+    template <typename... Args>
+    void emplaceAt(size_type pos, Args&&... args)
+    {
+        bool atFront = pos < nonitem - pos;
+        bool full = atFront ? frontRoom() == 0 : backRoom() == 0;
+        if(full || (pos != 0 && pos != nonitem))
+        {
+            Type item(std::forward<Args>(args)...);
+            if(full && atFront)
+                makeRoomAtFront();
+            else if(full)
+                makeLongerArray();
+            insertAt(pos, atFront, std::move(item));
+            return;
+        }
+        if(atFront)
+        {
+            construct(array - 1, std::forward<Args>(args)...);
+            --array;
+        }
+        else
+        {
+            construct(array + nonitem, std::forward<Args>(args)...);
+        }
+        nonitem++;
+    }
+
+    // Removes [pos, pos + count) by shifting whichever side is shorter; never reallocates.
+    void removeAt(size_type pos, size_type count = 1)
+    {
+        if(pos < nonitem - pos - count)
+        {
+            moveRange(array, array + pos, array + count);
+            destroy(array, array + count);
+            array += count;
+        }
+        else
+        {
+            moveRange(array + pos + count, array + nonitem, array + pos);
+            destroy(array + nonitem - count, array + nonitem);
+        }
+        nonitem -= count;
+        if(nonitem == 0)
+            array = storage;
+    }
+
+    // Makes the elements a copy of [source, source + n): live elements are copy-assigned in
+    // place, the rest copy-constructed, any surplus destroyed. The buffer must hold n
+    // elements from array on.
+    void assignRange(const Type* source, size_type n)
+    {
+        if constexpr (std::is_trivially_copyable<Type>::value)
+        {
+            if(n > 0)
+                std::memcpy(static_cast<void*>(array), source, n * sizeof(Type));
+            nonitem = n;
+            return;
+        }
+        else
+        {
+            size_type common = n < nonitem ? n : nonitem;
+            for(size_type i = 0; i < common; i++)
+                array[i] = source[i];
+            destroy(array + common, array + nonitem);
+            nonitem = common;
+            for(; nonitem < n; nonitem++)
+                construct(array + nonitem, source[nonitem]);
+        }
+    }
+
+    // Stable single pass from first on: survivors are moved down over the removed elements
+    // and the leftover tail is destroyed. The buffer is kept as is. If pred throws, the
+    // elements not yet visited are kept as well.
+    template <typename Predicate>
+    size_type compactFrom(size_type first, Predicate& pred)
+    {
+        size_type kept = first;
+        size_type curr = first;
+        try
+        {
+            for(; curr < nonitem; curr++)
+                if(!pred(static_cast<const Type&>(array[curr])))
+                {
+                    if(kept != curr)
+                        array[kept] = std::move(array[curr]);
+                    kept++;
+                }
+        }
+        catch(...)
+        {
+            moveRange(array + curr, array + nonitem, array + kept);
+            kept += nonitem - curr;
+            destroy(array + kept, array + nonitem);
+            nonitem = kept;
+            throw;
+        }
+        destroy(array + kept, array + nonitem);
+        size_type removed = nonitem - kept;
+        nonitem = kept;
+        if(nonitem == 0)
+            array = storage;
+        return removed;
+    }
+
+    // Takes other's elements; this must be empty. A buffer other does not own on the heap, or
+    // one from an unequal allocator, cannot be handed over, and neither is it worth dropping our own inline buffer for a
+    // payload that fits in it: in both cases the elements are relocated instead.
+    void takeFrom(Vector& other)
+    {
+        if(other.usesInlineStorage() || (usesInlineStorage() && other.getSize() <= capacity())
+           || alloc() != other.alloc())
+        {
+            reserve(other.nonitem);
+            relocate(other.array, other.array + other.nonitem, array);
+            nonitem = other.nonitem;
+            other.nonitem = 0;
+            other.array = other.storage;
+            return;
+        }
+        releaseStorage();
+        storage = other.storage;
+        array = other.array;
+        length = other.length;
+        nonitem = other.nonitem;
+
+        other.storage = nullptr;
+        other.array = nullptr;
+        other.length = 0;
+        other.nonitem = 0;
+    }
+
+protected:
+    // Lets a derived container supply a buffer it owns (see SmallVector). It is used until
+    // the elements outgrow it and is never deallocated by Vector.
+    Vector(Type* buffer, size_type bufferLength, const Allocator& allocator = Allocator())
+        : Allocator(allocator)
+    {
+        storage = buffer;
+        array = buffer;
+        inlineStorage = buffer;
+        nonitem = 0;
+        length = bufferLength;
+    }
+
+    bool usesInlineStorage() const
+    {
+        return storage != nullptr && storage == inlineStorage;
+    }
+
+    // Points an emptied object, whose heap buffer was handed over, back at its inline buffer.
+    void restoreInlineStorage(size_type bufferLength)
+    {
+        if(storage != nullptr || inlineStorage == nullptr)
+            return;
+        storage = array = inlineStorage;
+        length = bufferLength;
+    }
+
+    // Moves the elements from the heap back into the inline buffer of bufferLength slots,
+    // which must hold them all, and frees the heap buffer.
+    void returnToInlineStorage(size_type bufferLength)
+    {
+        if(inlineStorage == nullptr || usesInlineStorage())
+            return;
+        relocate(array, array + nonitem, inlineStorage);
+        releaseStorage();
+        storage = array = inlineStorage;
+        length = bufferLength;
+    }
+
+    // Move assignment without the noexcept promise: elements held in an inline buffer on
+    // either side are relocated one by one, which may allocate or throw.
+    void moveAssign(Vector& other)
+    {
+        if(this == &other)
+            return;
+        erase(begin(),end());
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+        {
+            if(alloc() != other.alloc())
+            {
+                releaseStorage();
+                storage = array = nullptr;
+                length = 0;
+                alloc() = std::move(other.alloc());
+            }
+        }
+        takeFrom(other);
+    }
 
 public:
-    Vector()
+    Vector() : Vector(Allocator())
+    {
+    }
+
+    explicit Vector(const Allocator& allocator)
+        : Allocator(allocator)
     {
-        array = new Type[ARRAYLENGTH];
+        storage = nullptr;
+        array = nullptr;
+        inlineStorage = nullptr;
         nonitem = 0;
-        length = ARRAYLENGTH;
+        length = 0;
     }
 
-    Vector(std::initializer_list<Type> l) : Vector()
+    Vector(std::initializer_list<Type> l, const Allocator& allocator = Allocator())
+        : Vector(allocator)
     {
-        if (l.size() > length)
-            makeLongerArray(l.size());
+        reserve(l.size());
         for(auto it = l.begin(); it != (l.end()); ++it)
             append(*it);
     }
 
+    // Allocates once, exactly other.getSize() slots; later growth follows GrowthPolicy.
     Vector(const Vector& other)
+        : Allocator(AllocTraits::select_on_container_copy_construction(other.getAllocator()))
     {
         nonitem = 0;
-        length = other.getSize()*2;
-        array = new Type[other.getSize()*2];
-
-        for(auto it = other.begin(); it != other.end(); ++it)
-            append(*it);
+        length = other.getSize();
+        storage = array = allocate(length);
+        inlineStorage = nullptr;
+        try
+        {
+            assignRange(other.array, other.nonitem);
+        }
+        catch(...)
+        {
+            destroy(array, array + nonitem);
+            deallocate(storage, length);
+            throw;
+        }
     }
 
-    Vector(Vector&& other) :Vector()
+    // Takes over other's buffer and allocates nothing.
+    Vector(Vector&& other) noexcept :Vector(other.alloc())
     {
-        auto nonitempp = nonitem;
-        auto lengthpp = length;
-        auto arraypp = array;
-
-        nonitem = other.nonitem;
-        length = other.length;
-        array = other.array;
-
-        other.nonitem = nonitempp;
-        other.length = lengthpp;
-        other.array = arraypp;
+        takeFrom(other);
+    }
 
+    // Takes over a SmallVector's heap buffer; elements still held inline are relocated,
+    // which may allocate and throw. source keeps using its inline buffer afterwards.
+    template <std::size_t N>
+    Vector(SmallVector<Type, N>&& source) : Vector(source.getAllocator())
+    {
+        Vector& other = source;
+        takeFrom(other);
+        other.restoreInlineStorage(N);
     }
 
     ~Vector()
     {
-        delete[] array;
+        destroy(array, array + nonitem);
+        releaseStorage();
     }
 
+    // Reuses the current buffer whenever other fits in it, assigning over the live elements
+    // in place, so repeated copies between same-sized vectors allocate nothing. Otherwise
+    // the buffer is replaced by one of exactly other.getSize() slots.
     Vector& operator=(const Vector& other)
     {
-        delete[] array;
-        nonitem = 0;
-        if(other.getSize() > ARRAYLENGTH/2)
+        if(this == &other)
+            return *this;
+        if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
         {
-            array = new Type[other.getSize()*2];
-            length = other.getSize()*2;
+            if(alloc() != other.alloc())
+            {
+                destroy(array, array + nonitem);
+                nonitem = 0;
+                releaseStorage();
+                if(!usesInlineStorage())
+                {
+                    storage = nullptr;
+                    length = 0;
+                }
+                array = storage;
+                alloc() = other.alloc();
+            }
         }
-        else
+        if(other.nonitem > capacity())
         {
-            array = new Type[ARRAYLENGTH];
-            length = ARRAYLENGTH;
-
+            destroy(array, array + nonitem);
+            nonitem = 0;
+            array = storage;
+            if(other.nonitem > length)
+            {
+                releaseStorage();
+                storage = array = nullptr;
+                length = 0;
+                storage = array = allocate(other.nonitem);
+                length = other.nonitem;
+            }
         }
-        for(auto it = other.begin(); it != other.end(); ++it)
-            append(*it);
+        assignRange(other.array, other.nonitem);
         return *this;
     }
 
+    // Takes over other's buffer whenever the allocators allow it; otherwise the elements are
+    // relocated into a buffer from our own allocator.
     Vector& operator=(Vector&& other)
+        noexcept(AllocTraits::propagate_on_container_move_assignment::value
+                 || AllocTraits::is_always_equal::value)
     {
-        erase(begin(),end());
+        moveAssign(other);
+        return *this;
+    }
 
-        auto nonitemTemp = nonitem;
-        auto lengthTemp = length;
-        auto arrayTemp = array;
+    // Exchanges the buffers in O(1) without allocating. Allocators are exchanged only if they
+    // propagate on swap; otherwise they must compare equal. No inline buffer can take part:
+    // SmallVector, the only owner of one, does not expose its Vector base.
+    void swap(Vector& other) noexcept
+    {
+        if(this == &other)
+            return;
+        if constexpr (AllocTraits::propagate_on_container_swap::value)
+        {
+            using std::swap;
+            swap(alloc(), other.alloc());
+        }
+        std::swap(storage, other.storage);
+        std::swap(array, other.array);
+        std::swap(length, other.length);
+        std::swap(nonitem, other.nonitem);
+    }
 
-        nonitem = other.nonitem;
-        length = other.length;
-        array = other.array;
+    friend void swap(Vector& a, Vector& b) noexcept
+    {
+        a.swap(b);
+    }
+
+    // Buffer replacements so far (the first allocation does not count).
+    size_type reallocationCount() const
+    {
+        static_assert(Statistics::enabled, "Vector needs CountingGrowthStatistics to report statistics");
+        return stats().reallocations;
+    }
+
+    // Bytes of elements relocated by reallocations and in-buffer slides so far.
+    size_type bytesMoved() const
+    {
+        static_assert(Statistics::enabled, "Vector needs CountingGrowthStatistics to report statistics");
+        return stats().movedBytes;
+    }
 
-        other.nonitem = nonitemTemp;
-        other.length = lengthTemp;
-        other.array = arrayTemp;
+    void resetStatistics()
+    {
+        stats().reset();
+    }
 
+    allocator_type getAllocator() const
+    {
         return *this;
     }
 
@@ -130,43 +705,50 @@ public:
 
     void append(const Type& item)
     {
-        if(length < nonitem+1)
-            makeLongerArray();
-        array[nonitem] = item;
-        nonitem++;
+        emplaceAt(nonitem, item);
+    }
+
+    void append(Type&& item)
+    {
+        emplaceAt(nonitem, std::move(item));
     }
 
     void prepend(const Type& item)
     {
-        if(length < nonitem+1)
-            makeLongerArray();
-        for(int i = nonitem; i > 0; i--)
-        {
-            array[i] = array[i-1];
-        }
-        array[0] = item;
-        nonitem++;
+        emplaceAt(0, item);
+    }
+
+    void prepend(Type&& item)
+    {
+        emplaceAt(0, std::move(item));
     }
 
     void insert(const const_iterator& insertPosition, const Type& item)
     {
-        if (length < nonitem+1)
-            makeLongerArray();
-        if (insertPosition == cend())
-        {
-            append(item);
-            return;
-        }
-        if (insertPosition == cbegin())
-        {
-            prepend(item);
-            return;
-        }
+        emplaceAt(insertPosition.currEl, item);
+    }
 
-        for(int i = nonitem; i != insertPosition.currEl; i--)
-            array[i] = array[i-1];
-        nonitem++;
-        array[insertPosition.currEl] = item;
+    void insert(const const_iterator& insertPosition, Type&& item)
+    {
+        emplaceAt(insertPosition.currEl, std::move(item));
+    }
+
+    template <typename... Args>
+    void emplaceBack(Args&&... args)
+    {
+        emplaceAt(nonitem, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    void emplaceFront(Args&&... args)
+    {
+        emplaceAt(0, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    void emplace(const const_iterator& insertPosition, Args&&... args)
+    {
+        emplaceAt(insertPosition.currEl, std::forward<Args>(args)...);
     }
 
     Type popFirst()
@@ -174,34 +756,84 @@ public:
         if(isEmpty())
             throw std::logic_error("Cannot pop first element when vector is empty");
 
-        Type temp = array[0];
-        for(int i = 0; i < nonitem-1; i++)
-            array[i] = array[i+1];
-        nonitem--;
+        Type temp = std::move(array[0]);
+        removeAt(0);
 
         return temp;
     }
 
+    // Makes room at the back. A buffer that is mostly idle at the front (e.g. after many
+    // popFirst calls) is reused by sliding the elements to its middle.
     void makeLongerArray()
     {
-        Type *newArray;
-        newArray = new Type[length*2];
-        length *= 2;
-        for (int i = 0; i < nonitem; i++)
-            newArray[i] = array[i];
-        delete[] array;
-        array = newArray;
+        size_type spare = frontRoom();
+        if(worthSliding(spare))
+        {
+            slideTo(alignHead(spare/2, 0, spare));
+            return;
+        }
+        size_type newLength = grownLength(nonitem + 1);
+        reallocate(newLength, spare == 0 ? 0 : alignHead((newLength - nonitem)/2, 0, 0));
+    }
+
+    // Number of elements that fit before the back of the buffer is reached.
+    size_type capacity() const
+    {
+        return length - frontRoom();
+    }
+
+    // Largest element count the allocator can provide.
+    size_type maxSize() const
+    {
+        return AllocTraits::max_size(alloc());
+    }
+
+    void reserve(size_type n)
+    {
+        if(n > maxSize())
+            throw std::length_error("Cannot reserve beyond maxSize()");
+        if(n > capacity())
+            reallocate(n);
+    }
+
+    // An inline buffer (see SmallVector) is kept: it costs no heap memory.
+    void shrink_to_fit()
+    {
+        if(length > nonitem && !usesInlineStorage())
+            reallocate(nonitem);
     }
 
-    void makeLongerArray(int l)
+    void resize(size_type n)
     {
-        Type *newArray;
-        newArray = new Type[l*2];
-        length *= 2;
-        for (int i = 0; i < nonitem; i++)
-            newArray[i] = array[i];
-        delete[] array;
-        array = newArray;
+        if(n <= getSize())
+        {
+            destroy(array + n, array + nonitem);
+            nonitem = n;
+            return;
+        }
+        growFor(n);
+        while(getSize() < n)
+        {
+            construct(array + nonitem);
+            nonitem++;
+        }
+    }
+
+    void resize(size_type n, const Type& value)
+    {
+        if(n <= getSize())
+        {
+            destroy(array + n, array + nonitem);
+            nonitem = n;
+            return;
+        }
+        Type copy(value);
+        growFor(n);
+        while(getSize() < n)
+        {
+            construct(array + nonitem, copy);
+            nonitem++;
+        }
     }
 
     Type popLast()
@@ -209,8 +841,8 @@ public:
         if(isEmpty())
             throw std::logic_error("Cannot pop last element when collection is empty");
 
-        Type temp = array[nonitem-1];
-        nonitem--;
+        Type temp = std::move(array[nonitem-1]);
+        removeAt(nonitem-1);
 
         return temp;
     }
@@ -219,30 +851,100 @@ public:
     {
         if(isEmpty() || possition.currEl == nonitem)
             throw std::out_of_range("Cannot erase when collection is empty nor when you are trying to erase the end sentinel");
-        int erOne = possition.currEl;
-        for(int i = erOne; i < nonitem; i++)
-            array[i] = array[i+1];
-        --nonitem;
+        removeAt(possition.currEl);
     }
 
     void erase(const const_iterator& firstIncluded, const const_iterator& lastExcluded)
     {
-        if(firstIncluded == lastExcluded)
+        if(firstIncluded.currEl >= lastExcluded.currEl)
             return;
+        removeAt(firstIncluded.currEl, lastExcluded.currEl - firstIncluded.currEl);
+    }
 
-        int newLength = (getSize()-(firstIncluded.currEl-lastExcluded.currEl)+1);
-        Type* tmp = new Type[newLength];
-        int newNonItem = 0;
-        for(auto it = cbegin(); it != cend(); ++it)
-            if(it.currEl < firstIncluded.currEl || it.currEl >= lastExcluded.currEl)
+    // Removes every element pred accepts in one pass and returns how many went.
+    template <typename Predicate>
+    size_type removeIf(Predicate pred)
+    {
+        return compactFrom(0, pred);
+    }
+
+    // Skips the leading run without matches with the search kernels, then compacts.
+    size_type removeValue(const Type& value)
+    {
+        // Compaction would overwrite value if it is one of our own elements.
+        std::less<const Type*> before;
+        if(!before(&value, array) && before(&value, array + nonitem))
+        {
+            Type copy(value);
+            return removeValue(copy);
+        }
+        auto equal = [&value](const Type& item) { return item == value; };
+        return compactFrom(simd::findFirst(array, getSize(), value), equal);
+    }
+
+    // Introsort; integral elements in their natural order take the radix path instead.
+    template <typename Compare = std::less<>>
+    void sort(Compare cmp = Compare())
+    {
+        if constexpr (sorting::radixApplies<Type, Compare>())
+            if(getSize() >= sorting::RadixThreshold)
             {
-                tmp[newNonItem] = (*it);
-                newNonItem++;
+                sorting::radixSort(array, array + nonitem);
+                return;
             }
-        nonitem = newNonItem;
-        delete[] array;
-        array = tmp;
-        length = newLength;
+        sorting::introsort(array, array + nonitem, cmp);
+    }
+
+    // Keeps equal elements in their original order; merge sort with scratch space for half
+    // the elements, or the (stable) radix path where it applies.
+    template <typename Compare = std::less<>>
+    void stableSort(Compare cmp = Compare())
+    {
+        if constexpr (sorting::radixApplies<Type, Compare>())
+            if(getSize() >= sorting::RadixThreshold)
+            {
+                sorting::radixSort(array, array + nonitem);
+                return;
+            }
+        sorting::mergeSort(array, array + nonitem, cmp);
+    }
+
+    Type* data()
+    {
+        return array;
+    }
+
+    const Type* data() const
+    {
+        return array;
+    }
+
+    // Lookups over arithmetic types run on SSE2/AVX2 kernels picked at runtime.
+    const_iterator find(const Type& value) const
+    {
+        return cbegin() + static_cast<difference_type>(simd::findFirst(array, getSize(), value));
+    }
+
+    iterator find(const Type& value)
+    {
+        return iterator(static_cast<const Vector*>(this)->find(value));
+    }
+
+    bool contains(const Type& value) const
+    {
+        return simd::findFirst(array, getSize(), value) != getSize();
+    }
+
+    size_type count(const Type& value) const
+    {
+        return simd::count(array, getSize(), value);
+    }
+
+    // Position of the first element equal to value, or -1 when there is none.
+    difference_type indexOf(const Type& value) const
+    {
+        size_type index = simd::findFirst(array, getSize(), value);
+        return index == getSize() ? -1 : static_cast<difference_type>(index);
     }
 
     iterator begin()
@@ -258,12 +960,12 @@ public:
 
     const_iterator cbegin() const
     {
-        return ConstIterator(0, this, &array[0]);
+        return ConstIterator(0, this, array);
     }
 
     const_iterator cend() const
     {
-        return ConstIterator(nonitem, this, &array[nonitem]);
+        return ConstIterator(nonitem, this, array + nonitem);
     }
 
     const_iterator begin() const
@@ -278,22 +980,23 @@ public:
 
 };
 
-template <typename Type>
-class Vector<Type>::ConstIterator
+template <typename Type, std::size_t InitialCapacity, typename Allocator, typename GrowthPolicy,
+          typename IteratorPolicy, typename Statistics>
+class Vector<Type, InitialCapacity, Allocator, GrowthPolicy, IteratorPolicy, Statistics>::ConstIterator
 {
 public:
-    using iterator_category = std::bidirectional_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
     using value_type = typename Vector::value_type;
     using difference_type = typename Vector::difference_type;
     using pointer = typename Vector::const_pointer;
     using reference = typename Vector::const_reference;
 
 private:
-    const Vector<Type> *Cont;
+    const Vector *Cont;
 
 public:
-    mutable Type *pter;
-    mutable int currEl;
+    Type *pter;
+    size_type currEl;
 
 
     explicit ConstIterator()
@@ -302,7 +1005,7 @@ public:
         currEl = 0;
         Cont = NULL;
     }
-    ConstIterator(int currEll, const Vector<Type>* Contt, Type* value)
+    ConstIterator(size_type currEll, const Vector* Contt, Type* value)
     {
         currEl = currEll;
         Cont = Contt;
@@ -311,15 +1014,27 @@ public:
 
     reference operator*() const
     {
-        if(Cont->getSize() == currEl)
-            throw std::out_of_range("Cannot shell refer to value while pointing to the end sentinel");
+        if constexpr (IteratorPolicy::checked)
+            if(Cont->getSize() == currEl)
+                throw std::out_of_range("Cannot shell refer to value while pointing to the end sentinel");
         return *pter;
     }
 
+    pointer operator->() const
+    {
+        return &(operator*());
+    }
+
+    reference operator[](difference_type d) const
+    {
+        return *(*this + d);
+    }
+
     ConstIterator& operator++()
     {
-        if(Cont->getSize() < currEl+1)
-            throw std::out_of_range("Cannot increment beyond end sentinel");
+        if constexpr (IteratorPolicy::checked)
+            if(Cont->getSize() < currEl+1)
+                throw std::out_of_range("Cannot increment beyond end sentinel");
 
         currEl++;
         pter++;
@@ -328,8 +1043,9 @@ public:
 
     ConstIterator operator++(int)
     {
-        if(Cont->getSize() < currEl+1)
-            throw std::out_of_range("Cannot increment beyond end sentinel");
+        if constexpr (IteratorPolicy::checked)
+            if(Cont->getSize() < currEl+1)
+                throw std::out_of_range("Cannot increment beyond end sentinel");
 
         ConstIterator cur = *this;
         currEl++;
@@ -340,8 +1056,9 @@ public:
 
     ConstIterator& operator--()
     {
-        if(currEl == 0)
-            throw std::out_of_range("Cannot decrement before first");
+        if constexpr (IteratorPolicy::checked)
+            if(currEl == 0)
+                throw std::out_of_range("Cannot decrement before first");
         pter--;
         currEl--;
         return *this;
@@ -350,26 +1067,47 @@ public:
 
     ConstIterator operator--(int)
     {
-        if(currEl == 0)
-            throw std::out_of_range("Cannot decrement before first");
+        if constexpr (IteratorPolicy::checked)
+            if(currEl == 0)
+                throw std::out_of_range("Cannot decrement before first");
         ConstIterator cur = *this;
         pter--;
         currEl--;
         return cur;
     }
 
-    ConstIterator operator+(difference_type d) const
+    ConstIterator& operator+=(difference_type d)
     {
         currEl += d;
-        pter = &(Cont->array[currEl]);
+        pter += d;
         return *this;
     }
 
+    ConstIterator& operator-=(difference_type d)
+    {
+        return *this += -d;
+    }
+
+    ConstIterator operator+(difference_type d) const
+    {
+        ConstIterator result = *this;
+        return result += d;
+    }
+
+    friend ConstIterator operator+(difference_type d, const ConstIterator& it)
+    {
+        return it + d;
+    }
+
     ConstIterator operator-(difference_type d) const
     {
-        currEl -= d;
-        pter = &(Cont->array[currEl]);
-        return *this;
+        ConstIterator result = *this;
+        return result -= d;
+    }
+
+    difference_type operator-(const ConstIterator& other) const
+    {
+        return pter - other.pter;
     }
 
     bool operator==(const ConstIterator& other) const
@@ -381,10 +1119,32 @@ public:
     {
         return pter != other.pter;
     }
+
+    bool operator<(const ConstIterator& other) const
+    {
+        return pter < other.pter;
+    }
+
+    bool operator>(const ConstIterator& other) const
+    {
+        return other < *this;
+    }
+
+    bool operator<=(const ConstIterator& other) const
+    {
+        return !(other < *this);
+    }
+
+    bool operator>=(const ConstIterator& other) const
+    {
+        return !(*this < other);
+    }
 };
 
-template <typename Type>
-class Vector<Type>::Iterator : public Vector<Type>::ConstIterator
+template <typename Type, std::size_t InitialCapacity, typename Allocator, typename GrowthPolicy,
+          typename IteratorPolicy, typename Statistics>
+class Vector<Type, InitialCapacity, Allocator, GrowthPolicy, IteratorPolicy, Statistics>::Iterator
+    : public Vector<Type, InitialCapacity, Allocator, GrowthPolicy, IteratorPolicy, Statistics>::ConstIterator
 {
 public:
     using pointer = typename Vector::pointer;
@@ -425,27 +1185,65 @@ public:
         return result;
     }
 
+    Iterator& operator+=(difference_type d)
+    {
+        ConstIterator::operator+=(d);
+        return *this;
+    }
+
+    Iterator& operator-=(difference_type d)
+    {
+        ConstIterator::operator-=(d);
+        return *this;
+    }
+
     Iterator operator+(difference_type d) const
     {
         return ConstIterator::operator+(d);
     }
 
+    friend Iterator operator+(difference_type d, const Iterator& it)
+    {
+        return it + d;
+    }
+
     Iterator operator-(difference_type d) const
     {
         return ConstIterator::operator-(d);
     }
 
+    difference_type operator-(const ConstIterator& other) const
+    {
+        return ConstIterator::operator-(other);
+    }
+
     reference operator*() const
     {
         // ugly cast, yet reduces code duplication.
         return const_cast<reference>(ConstIterator::operator*());
     }
 
+    pointer operator->() const
+    {
+        return &(operator*());
+    }
 
+    reference operator[](difference_type d) const
+    {
+        return *(*this + d);
+    }
 };
 
-}
+namespace pmr
+{
 
-#endif // AISDI_LINEAR_VECTOR_H
+template <typename Type, std::size_t InitialCapacity = 40, typename GrowthPolicy = DoublingGrowth,
+          typename IteratorPolicy = DefaultIteratorPolicy, typename Statistics = NoGrowthStatistics>
+using Vector = aisdi::Vector<Type, InitialCapacity, std::pmr::polymorphic_allocator<Type>, GrowthPolicy,
+                             IteratorPolicy, Statistics>;
+
+}
 
+}
 
+#endif // AISDI_LINEAR_VECTOR_H
@@ -1,8 +1,20 @@
 #include <Vector.h>
+#include <Snapshot.h>
 
+#include <algorithm>
 #include <initializer_list>
 #include <complex>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/test_tools.hpp>
@@ -716,6 +728,858 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingRange_ThenSizeI
   BOOST_CHECK_EQUAL(collection.getSize(), 2);
 }
 
+namespace
+{
+
+struct CountedItem
+{
+  static int alive;
+  int value;
+
+  CountedItem(int v) : value(v) { ++alive; }
+  CountedItem(const CountedItem& other) : value(other.value) { ++alive; }
+  CountedItem(CountedItem&& other) : value(other.value) { ++alive; }
+  CountedItem& operator=(const CountedItem&) = default;
+  CountedItem& operator=(CountedItem&&) = default;
+  ~CountedItem() { --alive; }
+};
+
+int CountedItem::alive = 0;
+
+}
+
+BOOST_AUTO_TEST_CASE(GivenNonDefaultConstructibleType_WhenGrowingCollection_ThenOnlyLiveElementsAreConstructed)
+{
+  {
+    LinearCollection<CountedItem> collection;
+    for (int i = 0; i < 100; ++i)
+      collection.append(CountedItem(i));
+
+    BOOST_CHECK_EQUAL(CountedItem::alive, 100);
+    BOOST_CHECK_EQUAL(collection.popFirst().value, 0);
+    BOOST_CHECK_EQUAL(collection.popLast().value, 99);
+    BOOST_CHECK_EQUAL(CountedItem::alive, 98);
+  }
+  BOOST_CHECK_EQUAL(CountedItem::alive, 0);
+}
+
+struct MoveCountedItem
+{
+  static int moves;
+  int value;
+
+  MoveCountedItem(int v) : value(v) {}
+  MoveCountedItem(const MoveCountedItem&) = default;
+  MoveCountedItem(MoveCountedItem&& other) : value(other.value) { ++moves; }
+  MoveCountedItem& operator=(const MoveCountedItem&) = default;
+  MoveCountedItem& operator=(MoveCountedItem&& other) { value = other.value; ++moves; return *this; }
+};
+
+int MoveCountedItem::moves = 0;
+
+BOOST_AUTO_TEST_CASE(GivenRoomAtFront_WhenEmplacingFront_ThenItemIsConstructedInPlace)
+{
+  LinearCollection<MoveCountedItem> collection;
+  collection.reserve(10);
+  for(int i = 0; i < 4; ++i)
+    collection.emplaceBack(i);
+  collection.popFirst();
+  collection.popFirst();
+  MoveCountedItem::moves = 0;
+
+  collection.emplaceFront(7);
+  collection.prepend((*(begin(collection) + 2)));
+
+  BOOST_CHECK_EQUAL(MoveCountedItem::moves, 0);
+  BOOST_CHECK_EQUAL(collection.getSize(), 4);
+  BOOST_CHECK_EQUAL((*begin(collection)).value, 3);
+  BOOST_CHECK_EQUAL((*(begin(collection) + 1)).value, 7);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenAppendingPastInitialCapacity_ThenAllItemsAreKept,
+                              T,
+                              TestedTypes)
+{
+  aisdi::Vector<T, 2> collection;
+  aisdi::Vector<T, 2> other(collection);
+
+  collection.append(1);
+  collection.append(2);
+  collection.append(3);
+  other = collection;
+
+  BOOST_CHECK_EQUAL(other.getSize(), 3);
+  BOOST_CHECK_EQUAL(*(other.end() - 1), T{3});
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenReserving_ThenCapacityGrowsAndSizeDoesNot,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection;
+
+  collection.reserve(1000);
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK_GE(collection.capacity(), 1000);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionCreatedFromList_WhenCheckingCapacity_ThenItFitsAllItems,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
+                                     20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36,
+                                     37, 38, 39, 40, 41, 42, 43, 44, 45 };
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 45);
+  BOOST_CHECK_GE(collection.capacity(), 45);
+  BOOST_CHECK_EQUAL(*(collection.end() - 1), T{45});
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionWithSpareCapacity_WhenShrinking_ThenCapacityEqualsSize,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+  collection.reserve(100);
+
+  collection.shrink_to_fit();
+
+  BOOST_CHECK_EQUAL(collection.capacity(), 3);
+  thenCollectionContainsValues(collection, { 1, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenResizing_ThenItemsAreAddedOrRemoved,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+
+  collection.resize(5, 7);
+  thenCollectionContainsValues(collection, { 1, 2, 3, 7, 7 });
+
+  collection.resize(6);
+  thenCollectionContainsValues(collection, { 1, 2, 3, 7, 7, 0 });
+
+  collection.resize(2);
+  thenCollectionContainsValues(collection, { 1, 2 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenResizingOneByOne_ThenCapacityGrowsGeometrically)
+{
+  aisdi::Vector<int, 2> collection;
+
+  for(int i = 0; i < 1000; ++i)
+    collection.resize(collection.getSize() + 1);
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 1000);
+  BOOST_CHECK_EQUAL(collection.capacity(), 1024);
+
+  collection.reserve(1500);
+  BOOST_CHECK_EQUAL(collection.capacity(), 1500);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMoveOnlyType_WhenInsertingRvaluesAndEmplacing_ThenItemsAreMovedIn)
+{
+  LinearCollection<std::unique_ptr<int>> collection;
+
+  collection.append(std::unique_ptr<int>(new int(2)));
+  collection.prepend(std::unique_ptr<int>(new int(1)));
+  collection.emplaceBack(new int(4));
+  collection.emplace(collection.begin() + 2, new int(3));
+  collection.emplaceFront(new int(0));
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 5);
+  int expected = 0;
+  for (auto it = collection.begin(); it != collection.end(); ++it)
+    BOOST_CHECK_EQUAL(**it, expected++);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenMixingFrontAndBackOperations_ThenOrderIsKept,
+                              T,
+                              TestedTypes)
+{
+  aisdi::Vector<T, 4> collection;
+
+  for (int i = 0; i < 50; ++i)
+  {
+    collection.prepend(1000 - i);
+    collection.append(i + 1);
+  }
+  for (int i = 0; i < 40; ++i)
+  {
+    BOOST_CHECK_EQUAL(collection.popFirst(), T(951 + i));
+    collection.append(51 + i);
+  }
+  collection.insert(collection.begin() + 1, 100);
+  collection.erase(collection.begin() + 2);
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 100);
+  BOOST_CHECK_EQUAL(*collection.begin(), T{991});
+  BOOST_CHECK_EQUAL(*(collection.begin() + 1), T{100});
+  BOOST_CHECK_EQUAL(*(collection.begin() + 2), T{993});
+  BOOST_CHECK_EQUAL(*(collection.end() - 1), T{90});
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollectionUsedAsQueue_WhenCycling_ThenBufferIsReused)
+{
+  LinearCollection<int> collection;
+  for (int i = 0; i < 10; ++i)
+    collection.append(i);
+  const auto capacityBefore = collection.capacity() + 10;
+
+  for (int i = 10; i < 10000; ++i)
+  {
+    collection.append(i);
+    BOOST_CHECK_EQUAL(collection.popFirst(), i - 10);
+  }
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 10);
+  BOOST_CHECK_LE(collection.capacity(), capacityBefore);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLargeCollection_WhenErasingRangeFromMiddle_ThenCapacityIsKept,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection;
+  for (int i = 0; i < 100; ++i)
+    collection.append(i);
+  const auto capacity = collection.capacity();
+
+  collection.erase(begin(collection) + 60, begin(collection) + 95);
+  collection.erase(begin(collection) + 5, begin(collection) + 20);
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 50);
+  BOOST_CHECK_GE(collection.capacity() + 15, capacity);
+  BOOST_CHECK_EQUAL(*(begin(collection) + 4), T{4});
+  BOOST_CHECK_EQUAL(*(begin(collection) + 5), T{20});
+  BOOST_CHECK_EQUAL(*(begin(collection) + 44), T{59});
+  BOOST_CHECK_EQUAL(*(begin(collection) + 45), T{95});
+}
+
+BOOST_AUTO_TEST_CASE(GivenNonTriviallyCopyableType_WhenShiftingItems_ThenValuesAreKept)
+{
+  LinearCollection<std::string> collection = { "a", "b", "c", "d", "e", "f" };
+
+  collection.insert(begin(collection) + 1, "x");
+  collection.insert(begin(collection) + 5, "y");
+  collection.erase(begin(collection) + 2);
+  collection.erase(begin(collection) + 4, begin(collection) + 6);
+
+  const std::initializer_list<std::string> expected = { "a", "x", "c", "d", "f" };
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection),
+                                begin(expected), end(expected));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenAddingOffset_ThenOriginalIsNotChanged,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 10, 20, 30, 40 };
+
+  auto it = collection.begin();
+  auto moved = it + 3;
+
+  BOOST_CHECK(it == collection.begin());
+  BOOST_CHECK_EQUAL(*moved, T{40});
+  BOOST_CHECK_EQUAL(moved - it, 3);
+  BOOST_CHECK_EQUAL(it[2], T{30});
+  BOOST_CHECK(it < moved);
+  BOOST_CHECK(moved - 3 == it);
+  BOOST_CHECK(1 + it == collection.cbegin() + 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenUsingRandomAccessAlgorithms_ThenTheyWork)
+{
+  LinearCollection<int> collection = { 5, 3, 9, 1, 7, 2, 8 };
+
+  std::nth_element(collection.begin(), collection.begin() + 3, collection.end());
+  BOOST_CHECK_EQUAL(collection.begin()[3], 5);
+
+  std::sort(collection.begin(), collection.end());
+  thenCollectionContainsValues(collection, { 1, 2, 3, 5, 7, 8, 9 });
+
+  auto found = std::lower_bound(collection.cbegin(), collection.cend(), 6);
+  BOOST_CHECK_EQUAL(found - collection.cbegin(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMonotonicResource_WhenFillingPmrCollection_ThenStorageComeFromTheResource)
+{
+  unsigned char buffer[4096];
+  std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+  aisdi::pmr::Vector<int> collection(&resource);
+
+  for (int i = 0; i < 100; ++i)
+    collection.append(i);
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 100);
+  BOOST_CHECK(collection.getAllocator().resource() == &resource);
+}
+
+BOOST_AUTO_TEST_CASE(GivenPmrCollections_WhenMoveAssigningAcrossResources_ThenItemsAreTransferred)
+{
+  std::pmr::monotonic_buffer_resource firstResource;
+  std::pmr::monotonic_buffer_resource secondResource;
+  aisdi::pmr::Vector<int> collection(&firstResource);
+  aisdi::pmr::Vector<int> other({ 1, 2, 3 }, &secondResource);
+
+  collection = std::move(other);
+
+  BOOST_CHECK(collection.getAllocator().resource() == &firstResource);
+  BOOST_CHECK(other.isEmpty());
+  const std::initializer_list<int> expected = { 1, 2, 3 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection),
+                                begin(expected), end(expected));
+}
+
+BOOST_AUTO_TEST_CASE(GivenArithmeticType_WhenGrowingCollection_ThenBufferStaysCacheLineAligned)
+{
+  LinearCollection<double> collection;
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    collection.append(i);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(&*collection.begin()) % 64, 0u);
+  }
+  collection.shrink_to_fit();
+
+  BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(&*collection.begin()) % 64, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenPoppedFirstItem_WhenGrowingCollection_ThenBufferRegainsAlignment)
+{
+  LinearCollection<double> collection;
+
+  for (int i = 0; i < 40; ++i)
+    collection.append(i);
+  collection.popFirst();
+  for (int i = 0; i < 1000; ++i)
+    collection.append(i);
+
+  BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(&*collection.begin()) % 64, 0u);
+  collection.prepend(-1.0);
+  collection.popFirst();
+  BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(&*collection.begin()) % 64, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(GivenHugePageAllocator_WhenAllocatingLargeBuffer_ThenItIsHugePageAligned)
+{
+  aisdi::Vector<std::uint8_t, 40, aisdi::HugePageAllocator<std::uint8_t>> collection;
+
+  collection.resize(aisdi::HugePageAllocator<std::uint8_t>::HugePageSize * 2, 1);
+
+  BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(&*collection.begin())
+                    % aisdi::HugePageAllocator<std::uint8_t>::HugePageSize, 0u);
+  BOOST_CHECK_EQUAL(*(collection.end() - 1), 1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenSearching_ThenMatchesAreFound,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection;
+  for (int i = 0; i < 100; ++i)
+    collection.append(i % 10);
+
+  BOOST_CHECK(collection.contains(7));
+  BOOST_CHECK(!collection.contains(10));
+  BOOST_CHECK_EQUAL(collection.count(3), 10u);
+  BOOST_CHECK_EQUAL(collection.indexOf(9), 9);
+  BOOST_CHECK_EQUAL(collection.indexOf(10), -1);
+  BOOST_CHECK(collection.find(4) == collection.begin() + 4);
+  BOOST_CHECK(collection.find(10) == collection.end());
+}
+
+BOOST_AUTO_TEST_CASE(GivenArithmeticTypes_WhenSearchingPastVectorWidth_ThenKernelsAgreeWithScalar)
+{
+  LinearCollection<std::uint8_t> bytes;
+  LinearCollection<std::int16_t> shorts;
+  LinearCollection<float> floats;
+  LinearCollection<double> doubles;
+  LinearCollection<std::int64_t> longs;
+  for (int i = 0; i < 1000; ++i)
+  {
+    bytes.append(i % 7);
+    shorts.append(i % 7);
+    floats.append(i % 7);
+    doubles.append(i % 7);
+    longs.append((i % 7) | (std::int64_t(i % 3) << 32));
+  }
+  bytes.append(200);
+  shorts.append(200);
+  floats.append(200);
+  doubles.append(200);
+  longs.append(200);
+
+  BOOST_CHECK_EQUAL(bytes.count(6), 142u);
+  BOOST_CHECK_EQUAL(shorts.count(6), 142u);
+  BOOST_CHECK_EQUAL(floats.count(6), 142u);
+  BOOST_CHECK_EQUAL(doubles.count(6), 142u);
+  BOOST_CHECK_EQUAL(longs.count(6), 48u);
+  BOOST_CHECK_EQUAL(bytes.indexOf(200), 1000);
+  BOOST_CHECK_EQUAL(shorts.indexOf(200), 1000);
+  BOOST_CHECK_EQUAL(floats.indexOf(200), 1000);
+  BOOST_CHECK_EQUAL(doubles.indexOf(200), 1000);
+  BOOST_CHECK_EQUAL(longs.indexOf(200), 1000);
+  BOOST_CHECK_EQUAL(longs.indexOf(6), 6);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenSavingAndLoadingSnapshot_ThenItemsRoundTrip,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 3, 1, 4, 1, 5, 9, 2, 6 };
+  LinearCollection<T> loaded = { 42 };
+  std::stringstream stream;
+
+  aisdi::saveTo(collection, stream);
+  aisdi::loadFrom(loaded, stream);
+
+  thenCollectionContainsValues(loaded, { 3, 1, 4, 1, 5, 9, 2, 6 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenStringCollection_WhenSavingToFileDescriptor_ThenItemsRoundTrip)
+{
+  LinearCollection<std::string> collection = { "ala", "", "ma kota i psa, a kot ma ale" };
+  LinearCollection<std::string> loaded;
+  std::FILE* file = std::tmpfile();
+  BOOST_REQUIRE(file != nullptr);
+
+  aisdi::saveTo(collection, fileno(file));
+  std::rewind(file);
+  aisdi::loadFrom(loaded, fileno(file));
+  std::fclose(file);
+
+  const std::initializer_list<std::string> expected = { "ala", "", "ma kota i psa, a kot ma ale" };
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(loaded), end(loaded), begin(expected), end(expected));
+}
+
+BOOST_AUTO_TEST_CASE(GivenCorruptedSnapshot_WhenLoading_ThenOperationThrowsAndCollectionIsEmpty)
+{
+  LinearCollection<int> collection = { 1, 2, 3 };
+  std::stringstream stream;
+  aisdi::saveTo(collection, stream);
+  std::string bytes = stream.str();
+  bytes[bytes.size() - 1] ^= 0x40;
+  std::stringstream corrupted(bytes);
+  std::stringstream truncated(bytes.substr(0, bytes.size() - 2));
+
+  BOOST_CHECK_THROW(aisdi::loadFrom(collection, corrupted), std::runtime_error);
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK_THROW(aisdi::loadFrom(collection, truncated), std::runtime_error);
+  BOOST_CHECK(collection.isEmpty());
+  collection.append(4);
+  std::stringstream foreign(std::string(64, 'x'));
+  BOOST_CHECK_THROW(aisdi::loadFrom(collection, foreign), std::runtime_error);
+  BOOST_CHECK(collection.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenHugeCount_WhenReservingOrLoading_ThenOperationThrows)
+{
+  LinearCollection<int> collection = { 1, 2, 3 };
+  std::uint64_t count = collection.maxSize() + 1;
+  std::uint64_t payloadBytes = count * sizeof(int);
+  std::stringstream stream;
+  aisdi::saveTo(LinearCollection<int>(), stream);
+  std::string bytes = stream.str();
+  std::memcpy(&bytes[16], &count, sizeof(count));
+  std::memcpy(&bytes[24], &payloadBytes, sizeof(payloadBytes));
+  std::stringstream forged(bytes);
+
+  BOOST_CHECK_THROW(collection.reserve(collection.maxSize() + 1), std::length_error);
+  BOOST_CHECK_THROW(aisdi::loadFrom(collection, forged), std::length_error);
+  BOOST_CHECK(collection.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenGrowthPolicies_WhenAppending_ThenCapacityFollowsPolicy)
+{
+  aisdi::Vector<int, 4, std::allocator<int>, aisdi::FixedIncrementGrowth<3>> fixed;
+  aisdi::Vector<int, 4, std::allocator<int>, aisdi::CappedDoublingGrowth<8>> capped;
+  aisdi::Vector<int, 4, std::allocator<int>, aisdi::OneAndHalfGrowth> oneAndHalf;
+
+  for(int i = 0; i < 5; ++i)
+  {
+    fixed.append(i);
+    oneAndHalf.append(i);
+  }
+  for(int i = 0; i < 33; ++i)
+    capped.append(i);
+
+  BOOST_CHECK_EQUAL(fixed.capacity(), 7);
+  BOOST_CHECK_EQUAL(oneAndHalf.capacity(), 7);
+  BOOST_CHECK_EQUAL(capped.capacity(), 40);
+}
+
+struct TripleGrowth
+{
+  std::size_t operator()(std::size_t capacity, std::size_t) const
+  {
+    return capacity * 3;
+  }
+};
+
+BOOST_AUTO_TEST_CASE(GivenCustomGrowthPolicy_WhenAppending_ThenStatisticsCountReallocations)
+{
+  aisdi::Vector<int, 2, std::allocator<int>, TripleGrowth, aisdi::DefaultIteratorPolicy,
+                aisdi::CountingGrowthStatistics> collection;
+
+  for(int i = 0; i < 19; ++i)
+    collection.append(i);
+
+  BOOST_CHECK_EQUAL(collection.capacity(), 54);
+  BOOST_CHECK_EQUAL(collection.reallocationCount(), 3);
+  BOOST_CHECK_EQUAL(collection.bytesMoved(), (2 + 6 + 18) * sizeof(int));
+
+  collection.resetStatistics();
+  BOOST_CHECK_EQUAL(collection.reallocationCount(), 0);
+  BOOST_CHECK_EQUAL(collection.bytesMoved(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenCopying_ThenCopyIsExactlySized)
+{
+  LinearCollection<int> collection = { 1, 2, 3 };
+
+  LinearCollection<int> copy{collection};
+  LinearCollection<int> assigned;
+  assigned = collection;
+
+  BOOST_CHECK_EQUAL(copy.capacity(), 3);
+  BOOST_CHECK_EQUAL(assigned.capacity(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(GivenDefaultStatistics_WhenCheckingSize_ThenCountersTakeNoSpace)
+{
+  using Counted = aisdi::Vector<int, 40, aisdi::DefaultAllocator<int>, aisdi::DoublingGrowth,
+                                aisdi::DefaultIteratorPolicy, aisdi::CountingGrowthStatistics>;
+
+  BOOST_CHECK_EQUAL(sizeof(LinearCollection<int>) + 2 * sizeof(std::size_t), sizeof(Counted));
+  Counted collection = { 1, 2, 3 };
+  Counted copy{collection};
+  BOOST_CHECK_EQUAL(copy.reallocationCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenUncheckedIterators_WhenIterating_ThenTheyWalkTheSameItems,
+                              T,
+                              TestedTypes)
+{
+  aisdi::Vector<T, 40, std::allocator<T>, aisdi::DoublingGrowth, aisdi::UncheckedIterators> collection;
+  for(int i = 5; i > 0; --i)
+    collection.append(i);
+
+  std::sort(begin(collection), end(collection), [](const T& a, const T& b) { return std::real(a) < std::real(b); });
+  auto it = end(collection);
+  --it;
+
+  const int expected[] = { 1, 2, 3, 4, 5 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection), begin(expected), end(expected));
+  BOOST_CHECK_EQUAL(*it, T(5));
+  BOOST_CHECK_EQUAL(end(collection) - begin(collection), 5);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCheckedIterators_WhenSteppingPastEnds_ThenOperationThrows)
+{
+  aisdi::Vector<int, 40, std::allocator<int>, aisdi::DoublingGrowth, aisdi::CheckedIterators> collection = { 1 };
+
+  BOOST_CHECK_THROW(*end(collection), std::out_of_range);
+  BOOST_CHECK_THROW(++end(collection), std::out_of_range);
+  BOOST_CHECK_THROW(--begin(collection), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenRemovingIf_ThenMatchingItemsAreRemovedInOrder,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3, 4, 5, 6, 7 };
+
+  auto removed = collection.removeIf([](const T& item) { return std::real(item) > 2 && std::real(item) < 6; });
+
+  BOOST_CHECK_EQUAL(removed, 3);
+  thenCollectionContainsValues(collection, { 1, 2, 6, 7 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenRemovingValue_ThenEveryCopyIsRemoved,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 4, 1, 4, 2, 4, 4, 3 };
+
+  BOOST_CHECK_EQUAL(collection.removeValue(4), 4);
+  BOOST_CHECK_EQUAL(collection.removeValue(9), 0);
+  thenCollectionContainsValues(collection, { 1, 2, 3 });
+  BOOST_CHECK_EQUAL(collection.removeIf([](const T&) { return true; }), 3);
+  BOOST_CHECK(collection.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenOwnElement_WhenRemovingValue_ThenEveryCopyIsRemoved)
+{
+  LinearCollection<std::string> collection = { "a", "b", "a", "c", "a" };
+
+  BOOST_CHECK_EQUAL(collection.removeValue(*collection.begin()), 3);
+
+  const std::string expected[] = { "b", "c" };
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection), begin(expected), end(expected));
+}
+
+BOOST_AUTO_TEST_CASE(GivenThrowingPredicate_WhenRemovingIf_ThenUnvisitedItemsAreKept)
+{
+  LinearCollection<std::string> collection = { "a", "x", "b", "stop", "x", "c" };
+
+  BOOST_CHECK_THROW(collection.removeIf([](const std::string& item)
+  {
+    if(item == "stop")
+      throw std::runtime_error("predicate failed");
+    return item == "x";
+  }), std::runtime_error);
+
+  const std::string expected[] = { "a", "b", "stop", "x", "c" };
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection), begin(expected), end(expected));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenSorting_ThenItemsAreOrderedByComparator,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 5, 3, 9, 1, 7, 2, 8, 6, 4 };
+  auto descending = [](const T& a, const T& b) { return std::real(a) > std::real(b); };
+
+  collection.sort(descending);
+  thenCollectionContainsValues(collection, { 9, 8, 7, 6, 5, 4, 3, 2, 1 });
+  collection.stableSort([](const T& a, const T& b) { return std::real(a) < std::real(b); });
+  thenCollectionContainsValues(collection, { 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenIntegralItems_WhenSorting_ThenResultMatchesStdSort)
+{
+  LinearCollection<std::int32_t> signedItems;
+  LinearCollection<std::uint64_t> unsignedItems;
+  std::vector<std::int32_t> signedExpected;
+  std::vector<std::uint64_t> unsignedExpected;
+  std::uint64_t seed = 12345;
+  for(int i = 0; i < 5000; ++i)
+  {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    signedItems.append(static_cast<std::int32_t>(seed >> 32));
+    signedExpected.push_back(static_cast<std::int32_t>(seed >> 32));
+    unsignedItems.append(seed % 100000 * 0x100000001ULL);
+    unsignedExpected.push_back(seed % 100000 * 0x100000001ULL);
+  }
+
+  signedItems.sort();
+  unsignedItems.stableSort();
+  std::sort(signedExpected.begin(), signedExpected.end());
+  std::sort(unsignedExpected.begin(), unsignedExpected.end());
+
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(signedItems), end(signedItems), signedExpected.begin(), signedExpected.end());
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(unsignedItems), end(unsignedItems), unsignedExpected.begin(), unsignedExpected.end());
+}
+
+BOOST_AUTO_TEST_CASE(GivenAdversarialOrders_WhenSorting_ThenResultIsSorted)
+{
+  for(int pattern = 0; pattern < 4; ++pattern)
+  {
+    LinearCollection<std::string> collection;
+    for(int i = 0; i < 3000; ++i)
+    {
+      int key = pattern == 0 ? i : pattern == 1 ? 3000 - i : pattern == 2 ? 7 : (i % 2 ? i : 3000 - i);
+      collection.append(std::to_string(100000 + key));
+    }
+
+    collection.sort();
+
+    BOOST_CHECK(std::is_sorted(begin(collection), end(collection)));
+    BOOST_CHECK_EQUAL(collection.getSize(), 3000);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenEqualKeys_WhenStableSorting_ThenOriginalOrderIsKept)
+{
+  LinearCollection<std::pair<int, int>> collection;
+  for(int i = 0; i < 1000; ++i)
+    collection.append({ (i * 7919) % 13, i });
+
+  collection.stableSort([](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; });
+
+  BOOST_CHECK(std::is_sorted(begin(collection), end(collection)));
+}
+
+template <typename T>
+struct LimitedAllocator : std::allocator<T>
+{
+  template <typename U>
+  struct rebind
+  {
+    using other = LimitedAllocator<U>;
+  };
+
+  LimitedAllocator() = default;
+
+  template <typename U>
+  LimitedAllocator(const LimitedAllocator<U>&)
+  {}
+
+  std::size_t max_size() const
+  {
+    return 100;
+  }
+};
+
+BOOST_AUTO_TEST_CASE(GivenAllocatorLimit_WhenGrowingPastIt_ThenCapacityIsClampedAndGrowthThrows)
+{
+  aisdi::Vector<int, 40, LimitedAllocator<int>> collection;
+
+  for(int i = 0; i < 100; ++i)
+    collection.append(i);
+
+  BOOST_CHECK_EQUAL(collection.capacity(), 100);
+  BOOST_CHECK_THROW(collection.append(100), std::length_error);
+  BOOST_CHECK_THROW(collection.reserve(101), std::length_error);
+  BOOST_CHECK_EQUAL(collection.getSize(), 100);
+  BOOST_CHECK_EQUAL(*(end(collection) - 1), 99);
+}
+
+struct WrappingGrowth
+{
+  std::size_t operator()(std::size_t capacity, std::size_t) const
+  {
+    return capacity * (std::size_t(1) << 63);
+  }
+};
+
+BOOST_AUTO_TEST_CASE(GivenPolicyResultWrappingAround_WhenGrowing_ThenCapacityIsClamped)
+{
+  aisdi::Vector<int, 40, LimitedAllocator<int>, WrappingGrowth> collection;
+
+  for(int i = 0; i < 41; ++i)
+    collection.append(i);
+
+  BOOST_CHECK_EQUAL(collection.capacity(), 100);
+}
+
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+  int allocations = 0;
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+  {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+};
+
+BOOST_AUTO_TEST_CASE(GivenLargeEnoughTarget_WhenCopyAssigningRepeatedly_ThenNothingIsAllocated)
+{
+  CountingResource resource;
+  aisdi::pmr::Vector<std::pmr::string> frame(&resource);
+  aisdi::pmr::Vector<std::pmr::string> target(&resource);
+  for(int i = 0; i < 50; ++i)
+    frame.append(std::pmr::string(40, 'a' + i % 26));
+  target = frame;
+  const std::pmr::string* buffer = target.data();
+  int copyAllocations = 0;
+
+  for(int round = 0; round < 10; ++round)
+  {
+    frame.popLast();
+    frame.append(std::pmr::string(40, 'z'));
+    int before = resource.allocations;
+    target = frame;
+    copyAllocations += resource.allocations - before;
+  }
+
+  BOOST_CHECK_EQUAL(copyAllocations, 0);
+  BOOST_CHECK(target.data() == buffer);
+  BOOST_CHECK_EQUAL(target.getSize(), 50);
+  BOOST_CHECK(*(end(target) - 1) == std::pmr::string(40, 'z'));
+}
+
+BOOST_AUTO_TEST_CASE(GivenTargetWithMoreItems_WhenCopyAssigning_ThenSurplusIsDestroyedAndBufferKept)
+{
+  auto shared = std::make_shared<int>(0);
+  aisdi::Vector<std::shared_ptr<int>> target;
+  aisdi::Vector<std::shared_ptr<int>> source;
+  for(int i = 0; i < 10; ++i)
+    target.append(shared);
+  source.append(std::make_shared<int>(1));
+  source.append(shared);
+  const std::shared_ptr<int>* buffer = target.data();
+
+  target = source;
+
+  BOOST_CHECK(target.data() == buffer);
+  BOOST_CHECK_EQUAL(target.getSize(), 2);
+  BOOST_CHECK_EQUAL(**begin(target), 1);
+  BOOST_CHECK_EQUAL(shared.use_count(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenCheckingMoveOperations_ThenTheyAreNoexcept)
+{
+  BOOST_CHECK(std::is_nothrow_move_constructible<LinearCollection<std::string>>::value);
+  BOOST_CHECK(std::is_nothrow_move_assignable<LinearCollection<std::string>>::value);
+  BOOST_CHECK(std::is_nothrow_swappable<LinearCollection<std::string>>::value);
+  BOOST_CHECK(!std::is_nothrow_move_assignable<aisdi::pmr::Vector<int>>::value);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoCollections_WhenSwapping_ThenBuffersAreExchanged,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+  LinearCollection<T> other = { 4, 5 };
+  const T* buffer = collection.data();
+  const T* otherBuffer = other.data();
+
+  swap(collection, other);
+
+  thenCollectionContainsValues(collection, { 4, 5 });
+  thenCollectionContainsValues(other, { 1, 2, 3 });
+  BOOST_CHECK(collection.data() == otherBuffer);
+  BOOST_CHECK(other.data() == buffer);
+}
+
+BOOST_AUTO_TEST_CASE(GivenPmrCollection_WhenMovingAndSwapping_ThenNothingIsAllocated)
+{
+  CountingResource resource;
+  aisdi::pmr::Vector<int> collection({ 1, 2, 3 }, &resource);
+  aisdi::pmr::Vector<int> other(&resource);
+  int before = resource.allocations;
+
+  aisdi::pmr::Vector<int> moved(std::move(collection));
+  other = std::move(moved);
+  swap(other, collection);
+
+  BOOST_CHECK_EQUAL(resource.allocations, before);
+  BOOST_CHECK(other.isEmpty());
+  BOOST_CHECK_EQUAL(collection.getSize(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(GivenStdVectorOfCollections_WhenItGrows_ThenInnerBuffersAreKept)
+{
+  std::vector<LinearCollection<std::string>> outer;
+  outer.emplace_back();
+  outer.back().append("first");
+  const std::string* buffer = outer.back().data();
+
+  for(int i = 0; i < 100; ++i)
+    outer.emplace_back();
+
+  BOOST_CHECK(outer.front().data() == buffer);
+  BOOST_CHECK_EQUAL(*begin(outer.front()), "first");
+}
+
 // ConstIterator is tested via Iterator methods.
 // If Iterator methods are to be changed, then new ConstIterator tests are required.
 
@@ -1,11 +1,18 @@
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <string>
+#include <type_traits>
 #include <iostream>
 #include <chrono>
+#include <list>
+#include <thread>
+#include <vector>
 
 #include "Vector.h"
 #include "LinkedList.h"
+#include "SpscRing.h"
 
 namespace
 {
@@ -83,6 +90,204 @@ std::chrono::nanoseconds performPopLastOnVector()
     return elapsedL;
 }
 
+std::chrono::nanoseconds performPopFirstOnList()
+{
+    LinearCollection<std::string> collection;
+
+    for (std::size_t i = 0; i < 10000; ++i)
+        collection.append("app");
+
+    auto startL = std::chrono::system_clock::now();
+    for (std::size_t i = 0; i < 10000; ++i)
+        collection.popFirst();
+    auto endL = std::chrono::system_clock::now();
+
+    auto elapsedL =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(endL - startL);
+    std::cout << "ListTest elapsed in   " << elapsedL.count() << " ns when popping first\n";
+
+    return elapsedL;
+}
+
+std::chrono::nanoseconds performPopFirstOnVector()
+{
+    Vector<std::string> collection;
+
+    for (std::size_t i = 0; i < 10000; ++i)
+        collection.append("app");
+
+    auto startL = std::chrono::system_clock::now();
+    for (std::size_t i = 0; i < 10000; ++i)
+        collection.popFirst();
+    auto endL = std::chrono::system_clock::now();
+
+    auto elapsedL =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(endL - startL);
+    std::cout << "VectorTest elapsed in   " << elapsedL.count() << " ns when popping first\n";
+
+    return elapsedL;
+}
+
+std::chrono::nanoseconds performHandoffOnRing()
+{
+    const std::size_t handoffs = 10000000;
+    const std::size_t batch = 64;
+    aisdi::SpscRing<std::size_t> ring(4096);
+
+    auto startR = std::chrono::system_clock::now();
+    std::thread producer([&]
+    {
+        std::size_t items[batch];
+        for (std::size_t sent = 0; sent < handoffs; )
+        {
+            std::size_t n = std::min(batch, handoffs - sent);
+            for (std::size_t i = 0; i < n; ++i)
+                items[i] = sent + i;
+            std::size_t pushed = ring.pushN(items, n);
+            while (pushed < n)
+            {
+                std::this_thread::yield();
+                pushed += ring.pushN(items + pushed, n - pushed);
+            }
+            sent += n;
+        }
+    });
+    std::size_t received = 0, checksum = 0;
+    std::size_t items[batch];
+    while (received < handoffs)
+    {
+        std::size_t n = ring.popN(items, batch);
+        if (n == 0)
+            std::this_thread::yield();
+        for (std::size_t i = 0; i < n; ++i)
+            checksum += items[i];
+        received += n;
+    }
+    producer.join();
+    auto endR = std::chrono::system_clock::now();
+
+    auto elapsedR =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(endR - startR);
+    if (checksum != handoffs * (handoffs - 1) / 2)
+        std::cout << "RingTest lost items\n";
+    std::cout << "RingTest elapsed in   " << elapsedR.count() << " ns for " << handoffs << " handoffs ("
+              << handoffs * 1000 / (elapsedR.count() / 1000000 + 1) << " per second)\n";
+
+    return elapsedR;
+}
+
+template <typename Collection>
+std::chrono::nanoseconds performSumOver(const char* name)
+{
+    Collection collection;
+    for (std::size_t i = 0; i < 1000000; ++i)
+        collection.append(static_cast<int>(i));
+
+    auto startS = std::chrono::system_clock::now();
+    long long sum = 0;
+    for (int round = 0; round < 10; ++round)
+        for (auto it = collection.begin(); it != collection.end(); ++it)
+            sum += *it;
+    auto endS = std::chrono::system_clock::now();
+
+    auto elapsedS =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(endS - startS);
+    std::cout << name << " elapsed in " << elapsedS.count() << " ns when iterating (sum " << sum << ")\n";
+
+    return elapsedS;
+}
+
+template <typename T>
+T randomItem(std::size_t& seed)
+{
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    if constexpr (std::is_same<T, std::string>::value)
+        return std::to_string(seed >> 20);
+    else
+        return static_cast<T>(seed >> 32);
+}
+
+template <typename T>
+std::chrono::nanoseconds performSortOnVector(std::size_t count)
+{
+    Vector<T> collection;
+    std::vector<T> reference;
+    std::size_t seed = 42;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        collection.append(randomItem<T>(seed));
+        reference.push_back(collection.data()[i]);
+    }
+
+    auto startV = std::chrono::system_clock::now();
+    collection.sort();
+    auto endV = std::chrono::system_clock::now();
+    std::sort(reference.begin(), reference.end());
+    auto endS = std::chrono::system_clock::now();
+
+    auto elapsedV = std::chrono::duration_cast<std::chrono::nanoseconds>(endV - startV);
+    auto elapsedS = std::chrono::duration_cast<std::chrono::nanoseconds>(endS - endV);
+    std::cout << "VectorTest elapsed in   " << elapsedV.count() << " ns when sorting, std::sort in "
+              << elapsedS.count() << " ns\n";
+
+    return elapsedV - elapsedS;
+}
+
+std::chrono::nanoseconds performSortOnList(std::size_t count)
+{
+    LinearCollection<int> collection;
+    std::list<int> reference;
+    std::size_t seed = 42;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        int item = randomItem<int>(seed);
+        collection.append(item);
+        reference.push_back(item);
+    }
+
+    auto startL = std::chrono::system_clock::now();
+    collection.sort();
+    auto endL = std::chrono::system_clock::now();
+    reference.sort();
+    auto endS = std::chrono::system_clock::now();
+
+    auto elapsedL = std::chrono::duration_cast<std::chrono::nanoseconds>(endL - startL);
+    auto elapsedS = std::chrono::duration_cast<std::chrono::nanoseconds>(endS - endL);
+    std::cout << "ListTest elapsed in   " << elapsedL.count() << " ns when sorting, std::list::sort in "
+              << elapsedS.count() << " ns\n";
+
+    return elapsedL - elapsedS;
+}
+
+// Grows a byte vector past 4 GiB one append at a time and spot-checks indexing and
+// iterator arithmetic beyond 2^32. Needs about 8 GiB of memory at the last reallocation,
+// so it only runs on request (--huge).
+std::chrono::nanoseconds performHugeVectorStress()
+{
+    const std::size_t count = (std::size_t(9) << 29) + 12345;
+    aisdi::Vector<std::uint8_t, 40, aisdi::DefaultAllocator<std::uint8_t>, aisdi::DoublingGrowth,
+                  aisdi::DefaultIteratorPolicy, aisdi::CountingGrowthStatistics> collection;
+
+    auto startH = std::chrono::system_clock::now();
+    for (std::size_t i = 0; i < count; ++i)
+        collection.append(static_cast<std::uint8_t>(i * 31));
+    auto endH = std::chrono::system_clock::now();
+
+    bool intact = collection.getSize() == count
+                  && static_cast<std::size_t>(collection.end() - collection.begin()) == count;
+    for (std::size_t i = count - 1; i > 0; i /= 3)
+        intact = intact && collection.data()[i] == static_cast<std::uint8_t>(i * 31)
+                 && *(collection.begin() + i) == static_cast<std::uint8_t>(i * 31);
+
+    auto elapsedH =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(endH - startH);
+    std::cout << "HugeVectorTest elapsed in " << elapsedH.count() << " ns appending " << count
+              << " bytes (" << collection.reallocationCount() << " reallocations, "
+              << (intact ? "contents intact" : "CONTENTS CORRUPTED") << ")\n";
+
+    return elapsedH;
+}
+
 void AreThereLeaks()
 {
     LinearCollection<std::string> collection;
@@ -111,6 +316,12 @@ void AreThereLeaks()
 
 int main(int argc, char** argv)
 {
+    if (argc > 1 && std::string(argv[1]) == "--huge")
+    {
+        performHugeVectorStress();
+        return 0;
+    }
+
     const std::size_t repeatCount = argc > 1 ? std::atoll(argv[1]) : 1;
 
     for (std::size_t i = 0; i < repeatCount; ++i)
@@ -119,6 +330,17 @@ int main(int argc, char** argv)
         {
             std::cout << "Difference when prepending       " << (performPrependOnVector()-performPrependOnList()).count() << " ns\n";
             std::cout << "Difference when popping last       " << (performPopLastOnVector()-performPopLastOnList()).count() << " ns\n";
+            std::cout << "Difference when popping first       " << (performPopFirstOnVector()-performPopFirstOnList()).count() << " ns\n";
+            performHandoffOnRing();
+            std::cout << "Difference to std when sorting ints    " << performSortOnVector<int>(1000000).count() << " ns\n";
+            std::cout << "Difference to std when sorting strings " << performSortOnVector<std::string>(200000).count() << " ns\n";
+            std::cout << "Difference to std when sorting list    " << performSortOnList(200000).count() << " ns\n";
+            std::cout << "Difference when iterating vector   "
+                      << (performSumOver<aisdi::Vector<int, 40, aisdi::DefaultAllocator<int>, aisdi::DoublingGrowth, aisdi::CheckedIterators>>("CheckedVector  ")
+                          - performSumOver<aisdi::Vector<int, 40, aisdi::DefaultAllocator<int>, aisdi::DoublingGrowth, aisdi::UncheckedIterators>>("UncheckedVector")).count() << " ns\n";
+            std::cout << "Difference when iterating list     "
+                      << (performSumOver<aisdi::LinkedList<int, std::allocator<int>, aisdi::CheckedIterators>>("CheckedList    ")
+                          - performSumOver<aisdi::LinkedList<int, std::allocator<int>, aisdi::UncheckedIterators>>("UncheckedList  ")).count() << " ns\n";
         }
 
     return 0;